@@ -0,0 +1,67 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/Arrange.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+const std::string USAGE_STR = {
+    "Usage: arrangebench [max_item_count]\n"
+    "Arranges increasing counts of small parts on a 250x210 mm bed and prints the time per count."
+};
+
+// A mix of small rectangles and L shaped parts of a few sizes, so that both
+// the alignment scoring and the big / small item branches are exercised.
+static Slic3r::arrangement::ArrangePolygons make_items(size_t count)
+{
+    using namespace Slic3r;
+    arrangement::ArrangePolygons items;
+    items.reserve(count);
+    for (size_t i = 0; i < count; ++ i) {
+        coord_t w = coord_t(scale_(4. + double(i % 5) * 3.));
+        coord_t h = coord_t(scale_(3. + double(i % 3) * 4.));
+        Polygon p;
+        if (i % 4 == 3)
+            p.points = { {0, 0}, {w, 0}, {w, h / 2}, {w / 2, h / 2}, {w / 2, h}, {0, h} };
+        else
+            p.points = { {0, 0}, {w, 0}, {w, h}, {0, h} };
+        arrangement::ArrangePolygon ap;
+        ap.poly.contour = std::move(p);
+        items.emplace_back(std::move(ap));
+    }
+    return items;
+}
+
+int main(const int argc, const char *argv[]) {
+    using namespace Slic3r;
+    using std::cout; using std::endl;
+
+    size_t max_count = 256;
+    if (argc > 1) {
+        if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+            cout << USAGE_STR << endl;
+            return EXIT_SUCCESS;
+        }
+        max_count = size_t(std::stoul(argv[1]));
+    }
+
+    BoundingBox bedbb(Point(0, 0), Point(coord_t(scale_(250.)), coord_t(scale_(210.))));
+    arrangement::BedShapeHint bedhint(bedbb);
+
+    cout << "items\tbeds\tseconds" << endl;
+    for (size_t count = 8; count <= max_count; count *= 2) {
+        arrangement::ArrangePolygons items = make_items(count);
+        Benchmark bench;
+        bench.start();
+        arrangement::arrange(items, coord_t(scale_(6.)), bedhint);
+        bench.stop();
+
+        int beds = 0;
+        for (const arrangement::ArrangePolygon &ap : items)
+            beds = std::max(beds, ap.bed_idx + 1);
+        cout << count << "\t" << beds << "\t" << bench.getElapsedSec() << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define CLIPPERBENCH_HEAP_STATS
+#endif
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/ClipperUtils.hpp>
+#include <libslic3r/ExPolygon.hpp>
+#include <libslic3r/Polygon.hpp>
+#include <libslic3r/Polyline.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+const std::string USAGE_STR = {
+    "Usage: clipperbench [iterations]\n"
+    "Runs diff, union_, intersection_ex, offset, offset2_ex and intersection_pl on 8x8 overlapping circles in a loop.\n"
+    "Prints the number of calls to operator new, the run time and, with glibc, the heap still held after a 40x40 grid\n"
+    "of 256 point circles has been unified and offset. To compare the ClipperUtils variants, build the sandbox at\n"
+    "each revision of ClipperUtils.cpp and clipper.cpp. All the variants shall print the same checksum."
+};
+
+// Counts the allocations of the whole process, the Clipper instances included.
+static std::atomic<size_t> g_allocs(0);
+void* operator new(size_t n) { ++ g_allocs; if (void *p = std::malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void* operator new[](size_t n) { ++ g_allocs; if (void *p = std::malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+static Slic3r::Polygon circle(double cx, double cy, double r, int n)
+{
+    using namespace Slic3r;
+    Polygon p;
+    for (int i = 0; i < n; ++ i) {
+        double a = 2. * PI * i / n;
+        p.points.emplace_back(coord_t(scale_(cx + r * cos(a))), coord_t(scale_(cy + r * sin(a))));
+    }
+    return p;
+}
+
+int main(const int argc, const char *argv[]) {
+    using namespace Slic3r;
+    using std::cout; using std::endl;
+
+    int iterations = 2000;
+    if (argc > 1) {
+        if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+            cout << USAGE_STR << endl;
+            return EXIT_SUCCESS;
+        }
+        iterations = std::atoi(argv[1]);
+    }
+
+    Polygons a, b;
+    for (int i = 0; i < 8; ++ i)
+        for (int j = 0; j < 8; ++ j) {
+            a.emplace_back(circle(i * 10., j * 10., 6., 64));
+            b.emplace_back(circle(i * 10. + 4., j * 10. + 3., 5., 48));
+        }
+    Polylines lines;
+    for (int i = 0; i < 16; ++ i)
+        lines.emplace_back(Polyline(Point(coord_t(scale_(-10.)), coord_t(scale_(i * 5.))), Point(coord_t(scale_(90.)), coord_t(scale_(i * 5. + 2.)))));
+
+    size_t checksum = 0;
+    size_t allocs0  = g_allocs;
+    Benchmark bench;
+    bench.start();
+    for (int it = 0; it < iterations; ++ it) {
+        checksum += diff(a, b).size();
+        checksum += union_(a, b).size();
+        checksum += intersection_ex(a, b).size();
+        checksum += offset(a, float(scale_(0.5))).size();
+        checksum += offset2_ex(b, float(scale_(-1.)), float(scale_(0.8))).size();
+        checksum += intersection_pl(lines, a).size();
+    }
+    bench.stop();
+    size_t allocs = g_allocs - allocs0;
+    cout << "iterations " << iterations << ", allocations " << allocs << ", seconds " << bench.getElapsedSec() << endl;
+
+    // A single large input followed by a small one: How much memory stays allocated in the reused Clipper instances.
+#ifdef CLIPPERBENCH_HEAP_STATS
+    struct mallinfo2 m0 = mallinfo2();
+#endif
+    {
+        Polygons big;
+        for (int i = 0; i < 40; ++ i)
+            for (int j = 0; j < 40; ++ j)
+                big.emplace_back(circle(i * 3., j * 3., 2., 256));
+        checksum += union_(big).size();
+        checksum += offset(big, float(scale_(0.2))).size();
+    }
+    checksum += union_(a, b).size();
+    checksum += offset(a, float(scale_(0.5))).size();
+#ifdef CLIPPERBENCH_HEAP_STATS
+    malloc_trim(0);
+    struct mallinfo2 m1 = mallinfo2();
+    cout << "heap kept after a large input " << (long long)(m1.uordblks - m0.uordblks) / 1024 << " KiB" << endl;
+#endif
+    cout << "checksum " << checksum << endl;
+
+    return EXIT_SUCCESS;
+}
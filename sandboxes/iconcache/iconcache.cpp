@@ -0,0 +1,119 @@
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/Utils.hpp>
+#include <slic3r/Utils/SVGRasterCache.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+namespace fs = boost::filesystem;
+
+const std::string USAGE_STR = {
+    "Usage: iconcache icons_dir\n"
+    "Runs three sessions of the SVG icon cache in a temporary directory: a cold one and a warm one at the 100% screen scale,\n"
+    "then one at 150%. Prints the time of each session, checks the cached rasters against a fresh rasterization and checks\n"
+    "that the rasters of the previous scale are removed once the scale changes."
+};
+
+using Slic3r::SVGRasterCache;
+
+// Icon heights at the screen scale given as the em unit, 10 at 100%.
+static std::vector<unsigned int> icon_heights(unsigned int scale) { return { 16 * scale / 10, 32 * scale / 10 }; }
+
+// Requests all the icons at the heights of the scale, as one session of the application does. Returns the number of mismatches.
+static size_t run_session(const std::string &icons_dir, const std::string &cache_dir, const std::vector<std::string> &icons, unsigned int scale, bool verify)
+{
+    Benchmark bench;
+    bench.start();
+    SVGRasterCache cache(icons_dir, cache_dir);
+    cache.preload();
+    std::vector<SVGRasterCache::Raster> rasters;
+    for (const std::string &icon : icons)
+        for (unsigned int height : icon_heights(scale)) {
+            rasters.emplace_back();
+            cache.get(icon, 0, height, rasters.back());
+        }
+    cache.save_index(scale);
+    bench.stop();
+    std::cout << "scale " << scale << ": " << rasters.size() << " icons in " << bench.getElapsedSec() * 1000. << " ms" << std::endl;
+
+    size_t num_mismatches = 0;
+    if (verify) {
+        auto it = rasters.begin();
+        for (const std::string &icon : icons)
+            for (unsigned int height : icon_heights(scale)) {
+                std::vector<char>      svg_data;
+                SVGRasterCache::Raster raster;
+                if (Slic3r::load_file((fs::path(icons_dir) / (icon + ".svg")).string(), svg_data) &&
+                    SVGRasterCache::rasterize(svg_data, 0, height, raster) &&
+                    (raster.width != it->width || raster.height != it->height || raster.rgba != it->rgba)) {
+                    std::cerr << "Cached raster of " << icon << " at height " << height << " differs from the rasterized one" << std::endl;
+                    ++ num_mismatches;
+                }
+                ++ it;
+            }
+    }
+    return num_mismatches;
+}
+
+// Hashes of the rasters of all the icons at the scale.
+static std::set<uint64_t> raster_hashes(const std::string &icons_dir, const std::vector<std::string> &icons, unsigned int scale)
+{
+    std::set<uint64_t> hashes;
+    for (const std::string &icon : icons) {
+        std::vector<char> svg_data;
+        if (Slic3r::load_file((fs::path(icons_dir) / (icon + ".svg")).string(), svg_data))
+            for (unsigned int height : icon_heights(scale))
+                hashes.insert(SVGRasterCache::raster_hash(svg_data, 0, height));
+    }
+    return hashes;
+}
+
+int main(const int argc, const char *argv[]) {
+    using std::cout; using std::endl;
+
+    if (argc < 2) {
+        cout << USAGE_STR << endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::string icons_dir = argv[1];
+    std::vector<std::string> icons;
+    for (fs::directory_iterator it(icons_dir), end; it != end; ++ it)
+        if (it->path().extension() == ".svg")
+            icons.emplace_back(it->path().stem().string());
+    if (icons.empty()) {
+        std::cerr << "No SVG icons found in " << icons_dir << endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string cache_dir = (fs::temp_directory_path() / fs::unique_path("iconcache-%%%%-%%%%")).string();
+    size_t num_errors = 0;
+    num_errors += run_session(icons_dir, cache_dir, icons, 10, false);
+    num_errors += run_session(icons_dir, cache_dir, icons, 10, true);
+    num_errors += run_session(icons_dir, cache_dir, icons, 15, true);
+
+    // Only the rasters of the last scale shall stay in the cache.
+    std::set<uint64_t> current = raster_hashes(icons_dir, icons, 15);
+    std::set<uint64_t> previous = raster_hashes(icons_dir, icons, 10);
+    size_t num_files = 0;
+    for (fs::directory_iterator it(cache_dir), end; it != end; ++ it)
+        if (it->path().extension() == ".rgba")
+            ++ num_files;
+    size_t num_stale = 0;
+    for (uint64_t hash : previous)
+        if (current.find(hash) == current.end() && fs::exists(fs::path(cache_dir) / (boost::format("%016x.rgba") % hash).str()))
+            ++ num_stale;
+    cout << num_files << " rasters cached, " << current.size() << " expected, " << num_stale << " left from the previous scale" << endl;
+    if (num_files != current.size() || num_stale > 0)
+        ++ num_errors;
+
+    fs::remove_all(cache_dir);
+    cout << (num_errors == 0 ? "OK" : "FAILED") << endl;
+    return num_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
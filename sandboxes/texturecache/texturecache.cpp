@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <libslic3r/libslic3r.h>
+#include <slic3r/Utils/Mipmaps.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+#include "nanosvg/nanosvg.h"
+
+namespace fs = boost::filesystem;
+
+const std::string USAGE_STR = {
+    "Usage: texturecache bedtexture.svg\n"
+    "Generates the compressed mipmaps of the bed texture for two maximum texture sizes of the OpenGL driver the same way\n"
+    "GLTexture::load_from_svg() does, stores them into a temporary texture cache and loads them back.\n"
+    "Prints the generation and the load times, checks the round trip and that each driver limit has its own cache entry."
+};
+
+using namespace Slic3r;
+
+// Rasterizes and compresses the levels of the SVG image, the largest side of the first level is max_size_px.
+static bool generate_levels(const std::string &path, unsigned int max_size_px, std::vector<MipmapLevel> &compressed)
+{
+    NSVGimage *image = nsvgParseFromFile(path.c_str(), "px", 96.0f);
+    if (image == nullptr)
+        return false;
+    float scale = (float)max_size_px / std::max(image->width, image->height);
+    // The stb_dxt compression needs the sizes to be multiples of 4.
+    MipmapLevel level;
+    level.w = ((unsigned int)(scale * image->width) + 3) / 4 * 4;
+    level.h = ((unsigned int)(scale * image->height) + 3) / 4 * 4;
+    compressed.clear();
+    for (;;) {
+        rasterize_svg(image, scale, level.w, level.h, level.data);
+        compressed.emplace_back();
+        compress_dxt5(level, compressed.back());
+        if (! mipmap_has_next(level.w, level.h))
+            break;
+        level.w = mipmap_next_size(level.w);
+        level.h = mipmap_next_size(level.h);
+        scale /= 2.0f;
+    }
+    nsvgDelete(image);
+    return true;
+}
+
+int main(const int argc, const char *argv[]) {
+    using std::cout; using std::endl;
+
+    if (argc < 2) {
+        cout << USAGE_STR << endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::string path      = argv[1];
+    std::string cache_dir = (fs::temp_directory_path() / fs::unique_path("texturecache-%%%%-%%%%")).string();
+    size_t      num_errors = 0;
+    {
+        MipmapCache cache(cache_dir);
+        std::vector<uint64_t> keys;
+        for (uint32_t max_tex_size : { 4096u, 2048u }) {
+            // The same texture parameters for both driver limits, the limit alone has to select the cache entry.
+            uint64_t key = MipmapCache::key(path, max_tex_size, { 1, 1, 4096 });
+            if (key == 0) {
+                std::cerr << "Failed to read " << path << endl;
+                return EXIT_FAILURE;
+            }
+            if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+                std::cerr << "The maximum texture size " << max_tex_size << " shares the cache entry of another size" << endl;
+                ++ num_errors;
+            }
+            keys.emplace_back(key);
+
+            std::vector<MipmapLevel> levels;
+            if (cache.load(key, levels)) {
+                std::cerr << "The cache is not empty for the maximum texture size " << max_tex_size << endl;
+                ++ num_errors;
+            }
+
+            Benchmark bench;
+            bench.start();
+            if (! generate_levels(path, max_tex_size, levels)) {
+                std::cerr << "Failed to parse " << path << endl;
+                return EXIT_FAILURE;
+            }
+            MipmapCache::Writer writer;
+            cache.store(key, writer);
+            for (const MipmapLevel &level : levels)
+                writer.append(level);
+            if (! writer.commit()) {
+                std::cerr << "Failed to store the texture" << endl;
+                ++ num_errors;
+            }
+            bench.stop();
+            double t_generate = bench.getElapsedSec();
+
+            std::vector<MipmapLevel> loaded;
+            bench.start();
+            bool ok = cache.load(key, loaded);
+            bench.stop();
+            ok = ok && loaded.size() == levels.size();
+            for (size_t i = 0; ok && i < levels.size(); ++ i)
+                ok = loaded[i].w == levels[i].w && loaded[i].h == levels[i].h && loaded[i].data == levels[i].data;
+            if (! ok) {
+                std::cerr << "The cached levels differ from the generated ones" << endl;
+                ++ num_errors;
+            }
+            cout << "max texture size " << max_tex_size << ": " << levels.size() << " levels, " << levels.front().w << "x" << levels.front().h
+                 << ", generated and stored in " << t_generate * 1000. << " ms, loaded in " << bench.getElapsedSec() * 1000. << " ms" << endl;
+        }
+    }
+    fs::remove_all(cache_dir);
+    cout << (num_errors == 0 ? "OK" : "FAILED") << endl;
+    return num_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
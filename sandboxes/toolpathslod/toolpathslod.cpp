@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+
+#include <libslic3r/libslic3r.h>
+#include <libslic3r/Model.hpp>
+#include <libslic3r/Print.hpp>
+#include <libslic3r/Layer.hpp>
+#include <libslic3r/ExtrusionEntityCollection.hpp>
+#include <slic3r/GUI/3DScene.hpp>
+#include <slic3r/GUI/GLCanvas3D.hpp>
+#include <libnest2d/tools/benchmark.h>
+
+const std::string USAGE_STR = {
+    "Usage: toolpathslod stlfilename.stl [config.ini]\n"
+    "Slices the model and prints the vertex count and the generation time of the toolpaths preview for each level of detail."
+};
+
+// Generates the toolpaths of all the layers of the print object into a single volume with the tolerance of the level,
+// the same way GLCanvas3D::_load_toolpaths_lod_spans() does. No OpenGL context is needed, the volume is not finalized.
+static void load_toolpaths(const Slic3r::PrintObject &print_object, double lod_tolerance, bool lod_coarse, Slic3r::GLVolume &volume)
+{
+    using namespace Slic3r;
+    for (const Layer *layer : print_object.layers())
+        for (const Point &copy : print_object.copies())
+            for (const LayerRegion *layerm : layer->regions()) {
+                _3DScene::extrusionentity_to_verts(layerm->perimeters, float(layer->print_z), copy, volume, lod_tolerance, lod_coarse);
+                _3DScene::extrusionentity_to_verts(layerm->fills, float(layer->print_z), copy, volume, lod_tolerance, lod_coarse);
+            }
+    for (const SupportLayer *layer : print_object.support_layers())
+        for (const Point &copy : print_object.copies())
+            _3DScene::extrusionentity_to_verts(layer->support_fills, float(layer->print_z), copy, volume, lod_tolerance, lod_coarse);
+}
+
+int main(const int argc, const char *argv[]) {
+    using namespace Slic3r;
+    using std::cout; using std::endl;
+
+    if(argc < 2) {
+        cout << USAGE_STR << endl;
+        return EXIT_SUCCESS;
+    }
+
+    DynamicPrintConfig config;
+    config.apply(FullPrintConfig::defaults());
+    if (argc > 2)
+        config.load(argv[2]);
+
+    Model model = Model::read_from_file(argv[1]);
+    for (ModelObject *mo : model.objects)
+        mo->ensure_on_bed();
+    model.center_instances_around_point(Vec2d(100., 100.));
+
+    Print print;
+    print.apply(model, config);
+    std::string err = print.validate();
+    if (! err.empty()) {
+        std::cerr << err << endl;
+        return EXIT_FAILURE;
+    }
+    print.process();
+
+    cout << "level\ttolerance\tvertices\ttriangles\tseconds" << endl;
+    for (int level = 0; level <= GUI::GLCanvas3D::ToolpathsLOD::Max_Level; ++ level) {
+        double    tolerance = GUI::GLCanvas3D::ToolpathsLOD::tolerance(level);
+        size_t    vertices  = 0;
+        size_t    triangles = 0;
+        Benchmark bench;
+        bench.start();
+        for (const PrintObject *print_object : print.objects()) {
+            GLVolume volume;
+            load_toolpaths(*print_object, scale_(tolerance), GUI::GLCanvas3D::ToolpathsLOD::coarse(level), volume);
+            vertices  += volume.indexed_vertex_array.vertices_and_normals_interleaved.size() / 6;
+            triangles += volume.indexed_vertex_array.triangle_indices.size() / 3 + volume.indexed_vertex_array.quad_indices.size() / 2;
+        }
+        bench.stop();
+        cout << level << "\t" << tolerance << "\t" << vertices << "\t" << triangles << "\t" << bench.getElapsedSec() << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -276,8 +276,12 @@ bool Poly2ContainsPoly1(OutPt *OutPt1, OutPt *OutPt2)
 inline bool SlopesEqual(const cInt dx1, const cInt dy1, const cInt dx2, const cInt dy2, bool UseFullInt64Range) {
   return (UseFullInt64Range) ?
     // |dx1| < 2^63, |dx2| < 2^63 etc,
+#ifdef HAS_INTRINSIC_128_TYPE
+    // The 64x64->128 bit multiply is a single instruction, the exact branch-free predicate is faster than the filtered one.
+    Int128::sign_determinant_2x2(dx1, dy1, dx2, dy2) == 0 :
+#else /* HAS_INTRINSIC_128_TYPE */
     Int128::sign_determinant_2x2_filtered(dx1, dy1, dx2, dy2) == 0 :
-//    Int128::sign_determinant_2x2(dx1, dy1, dx2, dy2) == 0 :
+#endif /* HAS_INTRINSIC_128_TYPE */
     // |dx1| < 2^31, |dx2| < 2^31 etc,
     // therefore the following computation could be done with 64bit arithmetics. 
     dy1 * dx2 == dx1 * dy2;
@@ -723,7 +727,7 @@ bool ClipperBase::AddPath(const Path &pg, PolyType PolyTyp, bool Closed)
     return false;
 
   // Allocate a new edge array.
-  std::vector<TEdge> edges(highI + 1);
+  std::vector<TEdge> edges = AllocateEdges(highI + 1);
   // Fill in the edge array.
   bool result = AddPathInternal(pg, highI, PolyTyp, Closed, edges.data());
   if (result)
@@ -756,7 +760,7 @@ bool ClipperBase::AddPaths(const Paths &ppg, PolyType PolyTyp, bool Closed)
     return false;
 
   // Allocate a new edge array.
-  std::vector<TEdge> edges(num_edges_total);
+  std::vector<TEdge> edges = AllocateEdges(num_edges_total);
   // Fill in the edge array.
   bool result = false;
   TEdge *p_edge = edges.data();
@@ -952,12 +956,36 @@ void ClipperBase::Clear()
 {
   PROFILE_FUNC();
   m_MinimaList.clear();
+  // Keep a couple of the edge vectors for reuse, but don't hold more than 4096 edges in total,
+  // so that a single large input does not bloat the instances kept by ClipperUtils for reuse.
+  static const size_t max_edges_kept = 4096;
+  size_t num_edges_kept = 0;
+  for (const std::vector<TEdge> &edges : m_edges_free)
+    num_edges_kept += edges.capacity();
+  for (std::vector<TEdge> &edges : m_edges)
+    if (m_edges_free.size() < 8 && num_edges_kept + edges.capacity() <= max_edges_kept) {
+      num_edges_kept += edges.capacity();
+      m_edges_free.emplace_back(std::move(edges));
+    }
   m_edges.clear();
   m_UseFullRange = false;
   m_HasOpenPaths = false;
 }
 //------------------------------------------------------------------------------
 
+// Allocate a vector of zero initialized edges, reuse the memory released by Clear() if possible.
+std::vector<TEdge> ClipperBase::AllocateEdges(size_t num_edges)
+{
+  std::vector<TEdge> edges;
+  if (! m_edges_free.empty()) {
+    edges = std::move(m_edges_free.back());
+    m_edges_free.pop_back();
+  }
+  edges.assign(num_edges, TEdge());
+  return edges;
+}
+//------------------------------------------------------------------------------
+
 // Initialize the Local Minima List:
 // Sort the LML entries, initialize the left / right bound edges of each Local Minima.
 void ClipperBase::Reset()
@@ -1036,6 +1064,7 @@ Clipper::Clipper(int initOptions) :
   ClipperBase(),
   m_OutPtsFree(nullptr),
   m_OutPtsChunkSize(32),
+  m_OutPtsChunkCurrent(size_t(-1)),
   m_OutPtsChunkLast(32),
   m_ActiveEdges(nullptr),
   m_SortedEdges(nullptr)
@@ -1054,7 +1083,9 @@ void Clipper::Reset()
 {
   PROFILE_FUNC();
   ClipperBase::Reset();
-  m_Scanbeam = std::priority_queue<cInt>();
+  // Clear the scanbeam while keeping its memory. It is usually empty after the previous Execute().
+  while (! m_Scanbeam.empty())
+    m_Scanbeam.pop();
   m_Maxima.clear();
   m_ActiveEdges = 0;
   m_SortedEdges = 0;
@@ -1175,28 +1206,43 @@ OutPt* Clipper::AllocateOutPt()
     pt = m_OutPtsFree;
     m_OutPtsFree = pt->Next;
   } else if (m_OutPtsChunkLast < m_OutPtsChunkSize) {
-    // Get a point from the last chunk.
-    pt = m_OutPts.back() + (m_OutPtsChunkLast ++);
+    // Get a point from the current chunk.
+    pt = m_OutPts[m_OutPtsChunkCurrent] + (m_OutPtsChunkLast ++);
   } else {
-    // The last chunk is full. Allocate a new one.
-    m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
+    // The current chunk is full. Take the next chunk kept from the previous Execute() or allocate a new one.
+    if (++ m_OutPtsChunkCurrent == m_OutPts.size())
+      m_OutPts.push_back(new OutPt[m_OutPtsChunkSize]);
     m_OutPtsChunkLast = 1;
-    pt = m_OutPts.back();
+    pt = m_OutPts[m_OutPtsChunkCurrent];
   }
   return pt;
 }
 
 void Clipper::DisposeAllOutRecs()
 {
-  for (OutPt *pts : m_OutPts)
-    delete[] pts;
+  // Keep up to 128 chunks (4096 points with the default chunk size) of the output points for the next Execute(),
+  // release the rest.
+  static const size_t max_chunks_kept = 128;
+  for (size_t i = max_chunks_kept; i < m_OutPts.size(); ++ i)
+    delete[] m_OutPts[i];
+  if (m_OutPts.size() > max_chunks_kept)
+    m_OutPts.resize(max_chunks_kept);
   for (OutRec *rec : m_PolyOuts)
     delete rec;
-  m_OutPts.clear();
   m_OutPtsFree = nullptr;
+  m_OutPtsChunkCurrent = size_t(-1);
   m_OutPtsChunkLast = m_OutPtsChunkSize;
   m_PolyOuts.clear();
 }
+
+void Clipper::ReleaseOutPts()
+{
+  for (OutPt *pts : m_OutPts)
+    delete[] pts;
+  m_OutPts.clear();
+  m_OutPtsChunkCurrent = size_t(-1);
+  m_OutPtsChunkLast = m_OutPtsChunkSize;
+}
 //------------------------------------------------------------------------------
 
 void Clipper::SetWindingCount(TEdge &edge) const
@@ -3326,6 +3372,7 @@ void ClipperOffset::Clear()
     delete m_polyNodes.Childs[i];
   m_polyNodes.Childs.clear();
   m_lowest.X = -1;
+  m_clipper.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -3433,7 +3480,8 @@ void ClipperOffset::Execute(Paths& solution, double delta)
   DoOffset(delta);
   
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3453,6 +3501,7 @@ void ClipperOffset::Execute(Paths& solution, double delta)
     clpr.Execute(ctUnion, solution, pftNegative, pftNegative);
     if (solution.size() > 0) solution.erase(solution.begin());
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
@@ -3463,7 +3512,8 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
   DoOffset(delta);
 
   //now clean up 'corners' ...
-  Clipper clpr;
+  Clipper &clpr = m_clipper;
+  clpr.ReverseSolution(false);
   clpr.AddPaths(m_destPolys, ptSubject, true);
   if (delta > 0)
   {
@@ -3494,6 +3544,7 @@ void ClipperOffset::Execute(PolyTree& solution, double delta)
     else
       solution.Clear();
   }
+  clpr.Clear();
 }
 //------------------------------------------------------------------------------
 
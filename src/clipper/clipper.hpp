@@ -296,6 +296,7 @@ public:
   void PreserveCollinear(bool value) {m_PreserveCollinear = value;};
 protected:
   bool AddPathInternal(const Path &pg, int highI, PolyType PolyTyp, bool Closed, TEdge* edges);
+  std::vector<TEdge> AllocateEdges(size_t num_edges);
   TEdge* AddBoundsToLML(TEdge *e, bool IsClosed);
   void Reset();
   TEdge* ProcessBound(TEdge* E, bool IsClockwise);
@@ -310,6 +311,8 @@ protected:
   bool              m_UseFullRange;
   // A vector of edges per each input path.
   std::vector<std::vector<TEdge>> m_edges;
+  // Edge vectors released by Clear(), their memory is reused by the following AddPath() / AddPaths().
+  std::vector<std::vector<TEdge>> m_edges_free;
   // Don't remove intermediate vertices of a collinear sequence of points.
   bool             m_PreserveCollinear;
   // Is any of the paths inserted by AddPath() or AddPaths() open?
@@ -321,7 +324,8 @@ class Clipper : public ClipperBase
 {
 public:
   Clipper(int initOptions = 0);
-  ~Clipper() { Clear(); }
+  ~Clipper() { Clear(); ReleaseOutPts(); }
+  // Clear the input and output, keep the allocated memory for the next use of this Clipper instance.
   void Clear() { ClipperBase::Clear(); DisposeAllOutRecs(); }
   bool Execute(ClipType clipType,
       Paths &solution,
@@ -355,10 +359,13 @@ private:
   // Output polygons.
   std::vector<OutRec*>  m_PolyOuts;
   // Output points, allocated by a continuous sets of m_OutPtsChunkSize.
+  // The chunks are kept by DisposeAllOutRecs() to be reused by the next Execute(), they are released by the destructor.
   std::vector<OutPt*>   m_OutPts;
   // List of free output points, to be used before taking a point from m_OutPts or allocating a new chunk.
   OutPt                *m_OutPtsFree;
   size_t                m_OutPtsChunkSize;
+  // Index of the chunk of m_OutPts, from which the output points are being taken.
+  size_t                m_OutPtsChunkCurrent;
   size_t                m_OutPtsChunkLast;
 
   std::vector<Join>     m_Joins;
@@ -413,6 +420,7 @@ private:
   void DisposeOutPt(OutPt *pt) { pt->Next = m_OutPtsFree; m_OutPtsFree = pt; }
   void DisposeOutPts(OutPt*& pp) { if (pp != nullptr) { pp->Prev->Next = m_OutPtsFree; m_OutPtsFree = pp; } }
   void DisposeAllOutRecs();
+  void ReleaseOutPts();
   bool ProcessIntersections(const cInt topY);
   void BuildIntersectList(const cInt topY);
   void ProcessEdgesAtTopOfScanbeam(const cInt topY);
@@ -459,6 +467,8 @@ private:
   double m_miterLim, m_StepsPerRad;
   IntPoint m_lowest;
   PolyNode m_polyNodes;
+  // Cleans up the offset polygons, kept to reuse its working memory by the next Execute().
+  Clipper m_clipper;
 
   void FixOrientations();
   void DoOffset(double delta);
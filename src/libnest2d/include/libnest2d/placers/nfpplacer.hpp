@@ -544,6 +544,16 @@ public:
 
     using Pile = nfp::Shapes<RawShape>;
 
+private:
+
+    // The union of the first merged_count_ packed items. Newly packed items
+    // are merged into it instead of merging the whole pile again for every
+    // candidate item.
+    Pile merged_pile_;
+    size_t merged_count_ = 0;
+
+public:
+
     inline explicit _NofitPolyPlacer(const BinType& bin):
         Base(bin),
         norm_(std::sqrt(sl::area(bin))) {}
@@ -626,6 +636,12 @@ public:
     inline void clearItems() {
         finalAlign(bin_);
         Base::clearItems();
+        resetMergedPile();
+    }
+
+    inline void unpackLast() {
+        Base::unpackLast();
+        resetMergedPile();
     }
 
 private:
@@ -787,6 +803,7 @@ private:
                     for(unsigned i = 0; i < items_.size(); i++) {
                         items_[i].get() = backup_cpy[i];
                     }
+                    resetMergedPile();
                 }
 
                 std::cout << iter << " repack result: " << score << " "
@@ -860,6 +877,8 @@ private:
             Radians final_rot = initial_rot;
             Shapes nfps;
 
+            Shapes& merged_pile = mergedPile();
+
             for(auto rot : config_.rotations) {
 
                 item.translation(initial_tr);
@@ -884,15 +903,6 @@ private:
                     ecache.back().accuracy(config_.accuracy);
                 }
 
-                Shapes pile;
-                pile.reserve(items_.size()+1);
-                // double pile_area = 0;
-                for(Item& mitem : items_) {
-                    pile.emplace_back(mitem.transformedShape());
-                    // pile_area += mitem.area();
-                }
-
-                auto merged_pile = nfp::merge(pile);
                 auto& bin = bin_;
                 double norm = norm_;
                 auto pbb = sl::boundingBox(merged_pile);
@@ -1115,6 +1125,30 @@ private:
         return ret;
     }
 
+    inline void resetMergedPile() {
+        merged_pile_.clear();
+        merged_count_ = 0;
+    }
+
+    // Packed items are only ever appended to items_ or removed through
+    // unpackLast() and clearItems(), so the items past merged_count_ are the
+    // only ones missing from the cached union.
+    Shapes& mergedPile() {
+        if(merged_count_ > items_.size()) resetMergedPile();
+
+        if(merged_count_ < items_.size()) {
+            merged_pile_.reserve(merged_pile_.size() +
+                                 items_.size() - merged_count_ + 1);
+            for(size_t i = merged_count_; i < items_.size(); ++i)
+                merged_pile_.emplace_back(items_[i].get().transformedShape());
+
+            merged_pile_ = nfp::merge(merged_pile_);
+            merged_count_ = items_.size();
+        }
+
+        return merged_pile_;
+    }
+
     inline void finalAlign(const RawShape& pbin) {
         auto bbin = sl::boundingBox(pbin);
         finalAlign(bbin);
@@ -19,6 +19,25 @@ private:
 
     Container store_;
 
+    // Knowledge about a bin which lets the selection skip the hopeless
+    // placement attempts without calling the placer. The inflated items
+    // packed into a bin don't overlap, and a bin can only get fuller, so an
+    // item larger than the free area left will never fit. The test does not
+    // depend on the placer or its objective function, therefore skipping
+    // such a bin does not change the result.
+    struct BinCache {
+        double free_area = 0.0;
+
+        explicit BinCache(double area): free_area(area) {}
+
+        bool canFit(const Item& item) const {
+            // Leave some slack for the rounding errors of the subtractions.
+            return item.area() <= free_area + 1e-9 * std::abs(free_area);
+        }
+
+        void packed(const Item& item) { free_area -= item.area(); }
+    };
+
 public:
 
     void configure(const Config& /*config*/) { }
@@ -39,6 +58,10 @@ public:
 
         std::vector<Placer> placers;
         placers.reserve(last-first);
+
+        std::vector<BinCache> caches;
+        caches.reserve(last-first);
+        const double bin_area = sl::area(bin);
         
         std::for_each(first, last, [this](Item& itm) {
             if(itm.isFixed()) {
@@ -61,6 +84,10 @@ public:
             placers.emplace_back(bin);
             placers.back().configure(pconfig);
             placers.back().preload(ig);
+
+            // The fixed items may reach out of the bin, leave them out of
+            // the free area estimate.
+            caches.emplace_back(bin_area);
         }
         
         auto sortfunc = [](Item& i1, Item& i2) {
@@ -96,8 +123,11 @@ public:
             size_t j = 0;
             while(!was_packed && !cancelled()) {
                 for(; j < placers.size() && !was_packed && !cancelled(); j++) {
+                    if(!caches[j].canFit(*it)) continue;
+
                     if((was_packed = placers[j].pack(*it, rem(it, store_) ))) {
                         it->get().binId(int(j));
+                        caches[j].packed(*it);
                         makeProgress(placers[j], j);
                     }
                 }
@@ -105,6 +135,7 @@ public:
                 if(!was_packed) {
                     placers.emplace_back(bin);
                     placers.back().configure(pconfig);
+                    caches.emplace_back(bin_area);
                     packed_bins_.emplace_back();
                     j = placers.size() - 1;
                 }
@@ -8,6 +8,7 @@
 #include <libnest2d/placers/nfpplacer.hpp>
 #include <libnest2d/selections/firstfit.hpp>
 
+#include <map>
 #include <numeric>
 #include <ClipperUtils.hpp>
 
@@ -134,24 +135,63 @@ protected:
     TBin      m_bin;
     double    m_bin_area;
 
+    // Spatial indices and the bounding box of a pile (the packed items of
+    // a logical bed). The pile only grows while its bed is being filled, so
+    // the state is updated with the newly placed items only.
+    struct PileIndex {
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4244)
 #pragma warning(disable: 4267)
 #endif
-    SpatIndex m_rtree; // spatial index for the normal (bigger) objects
-    SpatIndex m_smallsrtree;    // spatial index for only the smaller items
+        SpatIndex rtree;        // spatial index for the normal (bigger) objects
+        SpatIndex smallsrtree;  // spatial index for only the smaller items
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+        Box         pilebb;             // The bounding box of the pile.
+        size_t      count = 0;          // Number of the indexed items
+        const Item *last  = nullptr;    // The last indexed item
+    };
+    
+    // Indices of the piles of all logical beds, keyed by their item groups.
+    std::map<const ItemGroup*, PileIndex> m_pile_indices;
+    PileIndex         m_empty_pile;
+    const PileIndex  *m_pile = &m_empty_pile; // Index of the current pile
 
     double    m_norm;           // A coefficient to scale distances
-    MultiPolygon m_merged_pile; // The already merged pile (vector of items)
-    Box          m_pilebb;      // The bounding box of the merged pile.
-    ItemGroup m_remaining;      // Remaining items
-    ItemGroup m_items;          // allready packed items
+    const MultiPolygon *m_merged_pile = nullptr; // The already merged pile (vector of items)
+    size_t    m_remaining = 0;  // Number of the remaining items
+    const ItemGroup *m_items = nullptr; // allready packed items
     size_t    m_item_count = 0; // Number of all items to be packed
     
+    // Update the spatial indices of the pile with the newly placed items.
+    const PileIndex& update_pile_index(const ItemGroup &items)
+    {
+        // We will treat big items (compared to the print bed) differently
+        auto isBig = [this](double a) {
+            return a / m_bin_area > BIG_ITEM_TRESHOLD ;
+        };
+        
+        PileIndex &pile = m_pile_indices[&items];
+        if (items.size() < pile.count ||
+            (pile.count > 0 && &items[pile.count - 1].get() != pile.last))
+            // The items were removed or replaced, index the pile from scratch.
+            pile = PileIndex();
+        
+        for(size_t idx = pile.count; idx < items.size(); ++idx) {
+            Item& itm = items[idx];
+            auto bb = itm.boundingBox();
+            if(isBig(itm.area())) pile.rtree.insert({bb, unsigned(idx)});
+            pile.smallsrtree.insert({bb, unsigned(idx)});
+            // The bounding box of the merged pile is the bounding box of its items.
+            pile.pilebb = idx == 0 ? bb : sl::boundingBox(pile.pilebb, bb);
+        }
+        pile.count = items.size();
+        pile.last  = items.empty() ? nullptr : &items.back().get();
+        return pile;
+    }
+    
     template<class T> ArithmeticOnly<T, double> norm(T val)
     {
         return double(val) / m_norm;
@@ -166,8 +206,9 @@ protected:
     objfunc(const Item &item, const clppr::IntPoint &bincenter)
     {
         const double bin_area = m_bin_area;
-        const SpatIndex& spatindex = m_rtree;
-        const SpatIndex& smalls_spatindex = m_smallsrtree;
+        const SpatIndex& spatindex = m_pile->rtree;
+        const SpatIndex& smalls_spatindex = m_pile->smallsrtree;
+        const Box& pilebb = m_pile->pilebb;
         
         // We will treat big items (compared to the print bed) differently
         auto isBig = [bin_area](double a) {
@@ -178,7 +219,7 @@ protected:
         auto ibb = item.boundingBox();
         
         // Calculate the full bounding box of the pile with the candidate item
-        auto fullbb = sl::boundingBox(m_pilebb, ibb);
+        auto fullbb = sl::boundingBox(pilebb, ibb);
         
         // The bounding box of the big items (they will accumulate in the center
         // of the pile
@@ -209,8 +250,8 @@ protected:
         } compute_case;
         
         bool bigitems = isBig(item.area()) || spatindex.empty();
-        if(bigitems && !m_remaining.empty()) compute_case = BIG_ITEM;
-        else if (bigitems && m_remaining.empty()) compute_case = LAST_BIG_ITEM;
+        if(bigitems && m_remaining > 0) compute_case = BIG_ITEM;
+        else if (bigitems && m_remaining == 0) compute_case = LAST_BIG_ITEM;
         else compute_case = SMALL_ITEM;
         
         switch (compute_case) {
@@ -257,7 +298,7 @@ protected:
             // now get the score for the best alignment
             for(auto& e : result) { 
                 auto idx = e.second;
-                Item& p = m_items[idx];
+                Item& p = (*m_items)[idx];
                 auto parea = p.area();
                 if(std::abs(1.0 - parea/item.area()) < 1e-6) {
                     auto bb = sl::boundingBox(p.boundingBox(), ibb);
@@ -269,7 +310,7 @@ protected:
             }
             
             density = std::sqrt(norm(fullbb.width()) * norm(fullbb.height()));
-            double R = double(m_remaining.size()) / m_item_count;
+            double R = double(m_remaining) / m_item_count;
             
             // The final mix of the score is the balance between the
             // distance from the full pile center, the pack density and
@@ -284,7 +325,7 @@ protected:
             break;
         }
         case LAST_BIG_ITEM: {
-            score = norm(pl::distance(ibb.center(), m_pilebb.center()));
+            score = norm(pl::distance(ibb.center(), pilebb.center()));
             break;
         }
         case SMALL_ITEM: {
@@ -321,25 +362,11 @@ public:
                const ItemGroup& items,             // packed items
                const ItemGroup& remaining)         // future items to be packed
         {
-            m_items = items;
-            m_merged_pile = merged_pile;
-            m_remaining = remaining;
-
-            m_pilebb = sl::boundingBox(merged_pile);
-
-            m_rtree.clear();
-            m_smallsrtree.clear();
-            
-            // We will treat big items (compared to the print bed) differently
-            auto isBig = [this](double a) {
-                return a / m_bin_area > BIG_ITEM_TRESHOLD ;
-            };
-
-            for(unsigned idx = 0; idx < items.size(); ++idx) {
-                Item& itm = items[idx];
-                if(isBig(itm.area())) m_rtree.insert({itm.boundingBox(), idx});
-                m_smallsrtree.insert({itm.boundingBox(), idx});
-            }
+            // The arguments stay valid while the candidate item is evaluated.
+            m_items = &items;
+            m_merged_pile = &merged_pile;
+            m_remaining = remaining.size();
+            m_pile = &update_pile_index(items);
         };
         
         m_pconf.object_function = get_objfn();
@@ -351,7 +378,8 @@ public:
     }
     
     template<class It> inline void operator()(It from, It to) {
-        m_rtree.clear();
+        m_pile_indices.clear();
+        m_pile = &m_empty_pile;
         m_item_count += size_t(to - from);
         m_pck.execute(from, to);
         m_item_count = 0;
@@ -409,7 +437,7 @@ template<> std::function<double(const Item&)> AutoArranger<Circle>::get_objfn()
         };
         
         if(isBig(item)) {
-            auto mp = m_merged_pile;
+            auto mp = *m_merged_pile;
             mp.push_back(item.transformedShape());
             auto chull = sl::convexHull(mp);
             double miss = Placer::overfit(chull, m_bin);
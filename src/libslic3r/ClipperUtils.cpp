@@ -7,12 +7,64 @@
 #include "SVG.hpp"
 #endif /* CLIPPER_UTILS_DEBUG */
 
+#include <memory>
+
 #include <Shiny/Shiny.h>
 
 #define CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR (0.005f)
 
 namespace Slic3r {
 
+// Clipper and ClipperOffset allocate their working memory (edges, local minima, output points) with each use.
+// Instead of constructing them for each clipping operation, a couple of them are kept per thread,
+// cleared after use and reused, so that their working memory survives between the calls.
+// An instance is taken from the thread local pool, so that nested clipping operations do not share an instance.
+template<typename T>
+class ReusableClipper
+{
+public:
+    ReusableClipper() {
+        std::vector<std::unique_ptr<T>> &pool = thread_pool();
+        if (pool.empty())
+            m_object.reset(new T());
+        else {
+            m_object = std::move(pool.back());
+            pool.pop_back();
+        }
+    }
+    ~ReusableClipper() {
+        std::vector<std::unique_ptr<T>> &pool = thread_pool();
+        if (pool.size() < 4) {
+            reset(*m_object);
+            pool.emplace_back(std::move(m_object));
+        }
+    }
+
+    T& operator*()  { return *m_object; }
+    T* operator->() { return m_object.get(); }
+
+private:
+    static std::vector<std::unique_ptr<T>>& thread_pool() {
+        static thread_local std::vector<std::unique_ptr<T>> pool;
+        return pool;
+    }
+    // Clear the instance and set its parameters to the defaults of a newly constructed instance.
+    static void reset(ClipperLib::Clipper &clipper) {
+        clipper.Clear();
+        clipper.PreserveCollinear(false);
+        clipper.StrictlySimple(false);
+        clipper.ReverseSolution(false);
+    }
+    static void reset(ClipperLib::ClipperOffset &co) {
+        co.Clear();
+        co.MiterLimit         = 2.;
+        co.ArcTolerance       = 0.25;
+        co.ShortestEdgeLength = 0.;
+    }
+
+    std::unique_ptr<T> m_object;
+};
+
 #ifdef CLIPPER_UTILS_DEBUG
 bool clipper_export_enabled = false;
 // For debugging the Clipper library, for providing bug reports to the Clipper author.
@@ -154,13 +206,12 @@ ExPolygons
 ClipperPaths_to_Slic3rExPolygons(const ClipperLib::Paths &input)
 {
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ReusableClipper<ClipperLib::Clipper> clipper;
     
     // perform union
-    clipper.AddPaths(input, ClipperLib::ptSubject, true);
+    clipper->AddPaths(input, ClipperLib::ptSubject, true);
     ClipperLib::PolyTree polytree;
-    clipper.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);  // offset results work with both EvenOdd and NonZero
+    clipper->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);  // offset results work with both EvenOdd and NonZero
     
     // write to ExPolygons object
     return PolyTreeToExPolygons(polytree);
@@ -207,16 +258,16 @@ ClipperLib::Paths _offset(ClipperLib::Paths &&input, ClipperLib::EndType endType
     scaleClipperPolygons(input);
     
     // perform offset
-    ClipperLib::ClipperOffset co;
+    ReusableClipper<ClipperLib::ClipperOffset> co;
     if (joinType == jtRound)
-        co.ArcTolerance = miterLimit;
+        co->ArcTolerance = miterLimit;
     else
-        co.MiterLimit = miterLimit;
+        co->MiterLimit = miterLimit;
     float delta_scaled = delta * float(CLIPPER_OFFSET_SCALE);
-    co.ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-    co.AddPaths(input, joinType, endType);
+    co->ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+    co->AddPaths(input, joinType, endType);
     ClipperLib::Paths retval;
-    co.Execute(retval, delta_scaled);
+    co->Execute(retval, delta_scaled);
     
     // unscale output
     unscaleClipperPolygons(retval);
@@ -243,14 +294,14 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygon &expolygon, const float delta,
     {
         ClipperLib::Path input = Slic3rMultiPoint_to_ClipperPath(expolygon.contour);
         scaleClipperPolygon(input);
-        ClipperLib::ClipperOffset co;
+        ReusableClipper<ClipperLib::ClipperOffset> co;
         if (joinType == jtRound)
-            co.ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
+            co->ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
         else
-            co.MiterLimit = miterLimit;
-        co.ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-        co.AddPath(input, joinType, ClipperLib::etClosedPolygon);
-        co.Execute(contours, delta_scaled);
+            co->MiterLimit = miterLimit;
+        co->ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+        co->AddPath(input, joinType, ClipperLib::etClosedPolygon);
+        co->Execute(contours, delta_scaled);
     }
 
     // 2) Offset the holes one by one, collect the results.
@@ -260,15 +311,15 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygon &expolygon, const float delta,
         for (Polygons::const_iterator it_hole = expolygon.holes.begin(); it_hole != expolygon.holes.end(); ++ it_hole) {
             ClipperLib::Path input = Slic3rMultiPoint_to_ClipperPath_reversed(*it_hole);
             scaleClipperPolygon(input);
-            ClipperLib::ClipperOffset co;
+            ReusableClipper<ClipperLib::ClipperOffset> co;
             if (joinType == jtRound)
-                co.ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
+                co->ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
             else
-                co.MiterLimit = miterLimit;
-            co.ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-            co.AddPath(input, joinType, ClipperLib::etClosedPolygon);
+                co->MiterLimit = miterLimit;
+            co->ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+            co->AddPath(input, joinType, ClipperLib::etClosedPolygon);
             ClipperLib::Paths out;
-            co.Execute(out, - delta_scaled);
+            co->Execute(out, - delta_scaled);
             holes.insert(holes.end(), out.begin(), out.end());
         }
     }
@@ -278,11 +329,10 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygon &expolygon, const float delta,
     if (holes.empty()) {
         output = std::move(contours);
     } else {
-        ClipperLib::Clipper clipper;
-        clipper.Clear();
-        clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-        clipper.AddPaths(holes, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ReusableClipper<ClipperLib::Clipper> clipper;
+        clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+        clipper->AddPaths(holes, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     }
     
     // 4) Unscale the output.
@@ -309,14 +359,14 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygons &expolygons, const float delt
         {
             ClipperLib::Path input = Slic3rMultiPoint_to_ClipperPath(it_expoly->contour);
             scaleClipperPolygon(input);
-            ClipperLib::ClipperOffset co;
+            ReusableClipper<ClipperLib::ClipperOffset> co;
             if (joinType == jtRound)
-                co.ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
+                co->ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
             else
-                co.MiterLimit = miterLimit;
-            co.ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-            co.AddPath(input, joinType, ClipperLib::etClosedPolygon);
-            co.Execute(contours, delta_scaled);
+                co->MiterLimit = miterLimit;
+            co->ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+            co->AddPath(input, joinType, ClipperLib::etClosedPolygon);
+            co->Execute(contours, delta_scaled);
         }
         if (contours.empty())
             // No need to try to offset the holes.
@@ -333,15 +383,15 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygons &expolygons, const float delt
                 for (Polygons::const_iterator it_hole = it_expoly->holes.begin(); it_hole != it_expoly->holes.end(); ++ it_hole) {
                     ClipperLib::Path input = Slic3rMultiPoint_to_ClipperPath_reversed(*it_hole);
                     scaleClipperPolygon(input);
-                    ClipperLib::ClipperOffset co;
+                    ReusableClipper<ClipperLib::ClipperOffset> co;
                     if (joinType == jtRound)
-                        co.ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
+                        co->ArcTolerance = miterLimit * double(CLIPPER_OFFSET_SCALE);
                     else
-                        co.MiterLimit = miterLimit;
-                    co.ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
-                    co.AddPath(input, joinType, ClipperLib::etClosedPolygon);
+                        co->MiterLimit = miterLimit;
+                    co->ShortestEdgeLength = double(std::abs(delta_scaled * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR));
+                    co->AddPath(input, joinType, ClipperLib::etClosedPolygon);
                     ClipperLib::Paths out;
-                    co.Execute(out, - delta_scaled);
+                    co->Execute(out, - delta_scaled);
                     holes.insert(holes.end(), out.begin(), out.end());
                 }
             }
@@ -354,12 +404,11 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygons &expolygons, const float delt
             } else if (delta < 0) {
                 // Negative offset. There is a chance, that the offsetted hole intersects the outer contour. 
                 // Subtract the offsetted holes from the offsetted contours.
-                ClipperLib::Clipper clipper;
-                clipper.Clear();
-                clipper.AddPaths(contours, ClipperLib::ptSubject, true);
-                clipper.AddPaths(holes, ClipperLib::ptClip, true);
+                ReusableClipper<ClipperLib::Clipper> clipper;
+                clipper->AddPaths(contours, ClipperLib::ptSubject, true);
+                clipper->AddPaths(holes, ClipperLib::ptClip, true);
                 ClipperLib::Paths output;
-                clipper.Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+                clipper->Execute(ClipperLib::ctDifference, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
                 if (! output.empty()) {
                     contours_cummulative.insert(contours_cummulative.end(), output.begin(), output.end());
                     ++ expolygons_collected;
@@ -385,10 +434,9 @@ ClipperLib::Paths _offset(const Slic3r::ExPolygons &expolygons, const float delt
     ClipperLib::Paths output;
     if (expolygons_collected > 1 && delta > 0) {
         // There is a chance that the outwards offsetted expolygons may intersect. Perform a union.
-        ClipperLib::Clipper clipper;
-        clipper.Clear(); 
-        clipper.AddPaths(contours_cummulative, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ReusableClipper<ClipperLib::Clipper> clipper;
+        clipper->AddPaths(contours_cummulative, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     } else {
         // Negative offset. The shrunk expolygons shall not mutually intersect. Just copy the output.
         output = std::move(contours_cummulative);
@@ -410,26 +458,26 @@ _offset2(const Polygons &polygons, const float delta1, const float delta2,
     scaleClipperPolygons(input);
     
     // prepare ClipperOffset object
-    ClipperLib::ClipperOffset co;
+    ReusableClipper<ClipperLib::ClipperOffset> co;
     if (joinType == jtRound) {
-        co.ArcTolerance = miterLimit;
+        co->ArcTolerance = miterLimit;
     } else {
-        co.MiterLimit = miterLimit;
+        co->MiterLimit = miterLimit;
     }
     float delta_scaled1 = delta1 * float(CLIPPER_OFFSET_SCALE);
     float delta_scaled2 = delta2 * float(CLIPPER_OFFSET_SCALE);
-    co.ShortestEdgeLength = double(std::max(std::abs(delta_scaled1), std::abs(delta_scaled2)) * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR);
+    co->ShortestEdgeLength = double(std::max(std::abs(delta_scaled1), std::abs(delta_scaled2)) * CLIPPER_OFFSET_SHORTEST_EDGE_FACTOR);
     
     // perform first offset
     ClipperLib::Paths output1;
-    co.AddPaths(input, joinType, ClipperLib::etClosedPolygon);
-    co.Execute(output1, delta_scaled1);
+    co->AddPaths(input, joinType, ClipperLib::etClosedPolygon);
+    co->Execute(output1, delta_scaled1);
     
     // perform second offset
-    co.Clear();
-    co.AddPaths(output1, joinType, ClipperLib::etClosedPolygon);
+    co->Clear();
+    co->AddPaths(output1, joinType, ClipperLib::etClosedPolygon);
     ClipperLib::Paths retval;
-    co.Execute(retval, delta_scaled2);
+    co->Execute(retval, delta_scaled2);
     
     // unscale output
     unscaleClipperPolygons(retval);
@@ -490,16 +538,15 @@ _clipper_do(const ClipperLib::ClipType clipType, const Polygons &subject,
     }
     
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ReusableClipper<ClipperLib::Clipper> clipper;
     
     // add polygons
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, true);
-    clipper.AddPaths(input_clip,    ClipperLib::ptClip,    true);
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, true);
+    clipper->AddPaths(input_clip,    ClipperLib::ptClip,    true);
     
     // perform operation
     T retval;
-    clipper.Execute(clipType, retval, fillType, fillType);
+    clipper->Execute(clipType, retval, fillType, fillType);
     return retval;
 }
 
@@ -521,18 +568,18 @@ inline ClipperLib::PolyTree _clipper_do_polytree2(const ClipperLib::ClipType cli
     if (safety_offset_)
         safety_offset((clipType == ClipperLib::ctUnion) ? &input_subject : &input_clip);
     
-    ClipperLib::Clipper clipper;
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, true);
-    clipper.AddPaths(input_clip,    ClipperLib::ptClip,    true);
+    ReusableClipper<ClipperLib::Clipper> clipper;
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, true);
+    clipper->AddPaths(input_clip,    ClipperLib::ptClip,    true);
     // Perform the operation with the output to input_subject.
     // This pass does not generate a PolyTree, which is a very expensive operation with the current Clipper library
     // if there are overapping edges.
-    clipper.Execute(clipType, input_subject, fillType, fillType);
+    clipper->Execute(clipType, input_subject, fillType, fillType);
     // Perform an additional Union operation to generate the PolyTree ordering.
-    clipper.Clear();
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, true);
+    clipper->Clear();
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, true);
     ClipperLib::PolyTree retval;
-    clipper.Execute(ClipperLib::ctUnion, retval, fillType, fillType);
+    clipper->Execute(ClipperLib::ctUnion, retval, fillType, fillType);
     return retval;
 }
 
@@ -548,16 +595,15 @@ ClipperLib::PolyTree _clipper_do_pl(const ClipperLib::ClipType clipType, const P
     if (safety_offset_) safety_offset(&input_clip);
     
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ReusableClipper<ClipperLib::Clipper> clipper;
     
     // add polygons
-    clipper.AddPaths(input_subject, ClipperLib::ptSubject, false);
-    clipper.AddPaths(input_clip,    ClipperLib::ptClip,    true);
+    clipper->AddPaths(input_subject, ClipperLib::ptSubject, false);
+    clipper->AddPaths(input_clip,    ClipperLib::ptClip,    true);
     
     // perform operation
     ClipperLib::PolyTree retval;
-    clipper.Execute(clipType, retval, fillType, fillType);
+    clipper->Execute(clipType, retval, fillType, fillType);
     return retval;
 }
 
@@ -696,11 +742,11 @@ Polygons simplify_polygons(const Polygons &subject, bool preserve_collinear)
     
     ClipperLib::Paths output;
     if (preserve_collinear) {
-        ClipperLib::Clipper c;
-        c.PreserveCollinear(true);
-        c.StrictlySimple(true);
-        c.AddPaths(input_subject, ClipperLib::ptSubject, true);
-        c.Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        ReusableClipper<ClipperLib::Clipper> c;
+        c->PreserveCollinear(true);
+        c->StrictlySimple(true);
+        c->AddPaths(input_subject, ClipperLib::ptSubject, true);
+        c->Execute(ClipperLib::ctUnion, output, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     } else {
         ClipperLib::SimplifyPolygons(input_subject, output, ClipperLib::pftNonZero);
     }
@@ -719,11 +765,11 @@ ExPolygons simplify_polygons_ex(const Polygons &subject, bool preserve_collinear
     
     ClipperLib::PolyTree polytree;
     
-    ClipperLib::Clipper c;
-    c.PreserveCollinear(true);
-    c.StrictlySimple(true);
-    c.AddPaths(input_subject, ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    ReusableClipper<ClipperLib::Clipper> c;
+    c->PreserveCollinear(true);
+    c->StrictlySimple(true);
+    c->AddPaths(input_subject, ClipperLib::ptSubject, true);
+    c->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     
     // convert into ExPolygons
     return PolyTreeToExPolygons(polytree);
@@ -737,7 +783,7 @@ void safety_offset(ClipperLib::Paths* paths)
     scaleClipperPolygons(*paths);
     
     // perform offset (delta = scale 1e-05)
-    ClipperLib::ClipperOffset co;
+    ReusableClipper<ClipperLib::ClipperOffset> co;
 #ifdef CLIPPER_UTILS_DEBUG
     if (clipper_export_enabled) {
         static int iRun = 0;
@@ -747,20 +793,20 @@ void safety_offset(ClipperLib::Paths* paths)
     ClipperLib::Paths out;
     for (size_t i = 0; i < paths->size(); ++ i) {
         ClipperLib::Path &path = (*paths)[i];
-        co.Clear();
-        co.MiterLimit = 2;
+        co->Clear();
+        co->MiterLimit = 2;
         bool ccw = ClipperLib::Orientation(path);
         if (! ccw)
             std::reverse(path.begin(), path.end());
         {
             PROFILE_BLOCK(safety_offset_AddPaths);
-            co.AddPath((*paths)[i], ClipperLib::jtMiter, ClipperLib::etClosedPolygon);
+            co->AddPath((*paths)[i], ClipperLib::jtMiter, ClipperLib::etClosedPolygon);
         }
         {
             PROFILE_BLOCK(safety_offset_Execute);
             // offset outside by 10um
             ClipperLib::Paths out_this;
-            co.Execute(out_this, ccw ? 10.f * float(CLIPPER_OFFSET_SCALE) : -10.f * float(CLIPPER_OFFSET_SCALE));
+            co->Execute(out_this, ccw ? 10.f * float(CLIPPER_OFFSET_SCALE) : -10.f * float(CLIPPER_OFFSET_SCALE));
             if (! ccw) {
                 // Reverse the resulting contours once again.
                 for (ClipperLib::Paths::iterator it = out_this.begin(); it != out_this.end(); ++ it)
@@ -781,12 +827,11 @@ void safety_offset(ClipperLib::Paths* paths)
 Polygons top_level_islands(const Slic3r::Polygons &polygons)
 {
     // init Clipper
-    ClipperLib::Clipper clipper;
-    clipper.Clear();
+    ReusableClipper<ClipperLib::Clipper> clipper;
     // perform union
-    clipper.AddPaths(Slic3rMultiPoints_to_ClipperPaths(polygons), ClipperLib::ptSubject, true);
+    clipper->AddPaths(Slic3rMultiPoints_to_ClipperPaths(polygons), ClipperLib::ptSubject, true);
     ClipperLib::PolyTree polytree;
-    clipper.Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
+    clipper->Execute(ClipperLib::ctUnion, polytree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd); 
     // Convert only the top level islands to the output.
     Polygons out;
     out.reserve(polytree.ChildCount());
@@ -427,6 +427,49 @@ std::string ConfigBase::opt_serialize(const t_config_option_key &opt_key) const
     return opt->serialize();
 }
 
+ConfigSerializationCache::Entry& ConfigSerializationCache::entry(const t_config_option_key &opt_key, const ConfigOption &opt)
+{
+    Entry &entry = m_cache[opt_key];
+    if (! entry.opt || entry.opt->type() != opt.type() || *entry.opt != opt) {
+        entry.opt.reset(opt.clone());
+        entry.serialized_valid  = false;
+        entry.vserialized_valid = false;
+    }
+    return entry;
+}
+
+std::string ConfigSerializationCache::serialize(const t_config_option_key &opt_key, const ConfigOption &opt)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry &entry = this->entry(opt_key, opt);
+    if (! entry.serialized_valid) {
+        entry.serialized       = opt.serialize();
+        entry.serialized_valid = true;
+    }
+    return entry.serialized;
+}
+
+std::string ConfigSerializationCache::serialize_at(const t_config_option_key &opt_key, const ConfigOptionVectorBase &opt, size_t idx)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry &entry = this->entry(opt_key, opt);
+    if (! entry.vserialized_valid) {
+        entry.vserialized       = opt.vserialize();
+        entry.vserialized_valid = true;
+    }
+    assert(idx < entry.vserialized.size());
+    return entry.vserialized[idx];
+}
+
+void ConfigSerializationCache::append_config_block(const ConfigBase &config, std::function<bool(const t_config_option_key&, const ConfigOption&)> filter, std::string &out)
+{
+    for (const std::string &key : config.keys()) {
+        const ConfigOption *opt = config.option(key);
+        if (opt != nullptr && filter(key, *opt))
+            out += "; " + key + " = " + this->serialize(key, *opt) + "\n";
+    }
+}
+
 bool ConfigBase::set_deserialize(const t_config_option_key &opt_key_src, const std::string &value_src, bool append)
 {
     t_config_option_key opt_key = opt_key_src;
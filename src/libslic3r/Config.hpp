@@ -8,6 +8,8 @@
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -1743,6 +1745,45 @@ protected:
     void set_defaults();
 };
 
+// Cache of the serialized option values, to avoid serializing the same values over and over
+// (for example when appending the full config block to the G-code of many exports with nearly the same config,
+// or when expanding custom G-code and output file name templates).
+// A cached value is reused as long as the option compares equal to the option it was serialized from,
+// so the cache does not need to be invalidated explicitly. The cache is thread safe.
+class ConfigSerializationCache
+{
+public:
+    ConfigSerializationCache() {}
+    ConfigSerializationCache(const ConfigSerializationCache&) = delete;
+    ConfigSerializationCache& operator=(const ConfigSerializationCache&) = delete;
+
+    // Equivalent to opt.serialize().
+    std::string serialize(const t_config_option_key &opt_key, const ConfigOption &opt);
+    // Equivalent to opt.vserialize()[idx].
+    std::string serialize_at(const t_config_option_key &opt_key, const ConfigOptionVectorBase &opt, size_t idx);
+    // Equivalent to config.opt_serialize(opt_key).
+    std::string opt_serialize(const ConfigBase &config, const t_config_option_key &opt_key)
+        { const ConfigOption *opt = config.option(opt_key); assert(opt != nullptr); return this->serialize(opt_key, *opt); }
+    // Append a "; key = value" line for each option of config, for which filter returns true.
+    void append_config_block(const ConfigBase &config, std::function<bool(const t_config_option_key&, const ConfigOption&)> filter, std::string &out);
+
+    void clear() { std::lock_guard<std::mutex> lock(m_mutex); m_cache.clear(); }
+
+private:
+    struct Entry {
+        std::unique_ptr<ConfigOption>   opt;
+        std::string                     serialized;
+        std::vector<std::string>        vserialized;
+        bool                            serialized_valid  = false;
+        bool                            vserialized_valid = false;
+    };
+    // Returns the cache entry of opt_key, reset if the cached option differs from opt.
+    Entry&                              entry(const t_config_option_key &opt_key, const ConfigOption &opt);
+
+    std::mutex                                  m_mutex;
+    std::map<t_config_option_key, Entry>        m_cache;
+};
+
 }
 
 #endif
@@ -5,6 +5,7 @@
 #include "Extruder.hpp"
 #include "Flow.hpp"
 #include <cmath>
+#include <iterator>
 #include <limits>
 #include <sstream>
 
@@ -175,25 +176,28 @@ ExtrusionLoop::split_at_vertex(const Point &point)
                 path->polyline.points.erase(path->polyline.points.begin(), path->polyline.points.begin() + idx);
             } else {
                 // new paths list starts with the second half of current path
+                // (the paths are moved, not copied, as the old list is discarded)
                 ExtrusionPaths new_paths;
                 new_paths.reserve(this->paths.size() + 1);
                 {
-                    ExtrusionPath p = *path;
-                    p.polyline.points.erase(p.polyline.points.begin(), p.polyline.points.begin() + idx);
-                    if (p.polyline.is_valid()) new_paths.push_back(p);
+                    ExtrusionPath p(path->role(), path->mm3_per_mm, path->width, path->height);
+                    p.feedrate    = path->feedrate;
+                    p.extruder_id = path->extruder_id;
+                    p.cp_color_id = path->cp_color_id;
+                    p.polyline.points.assign(path->polyline.points.begin() + idx, path->polyline.points.end());
+                    if (p.polyline.is_valid()) new_paths.emplace_back(std::move(p));
                 }
             
                 // then we add all paths until the end of current path list
-                new_paths.insert(new_paths.end(), path+1, this->paths.end());  // not including this path
+                new_paths.insert(new_paths.end(), std::make_move_iterator(path+1), std::make_move_iterator(this->paths.end()));  // not including this path
             
                 // then we add all paths since the beginning of current list up to the previous one
-                new_paths.insert(new_paths.end(), this->paths.begin(), path);  // not including this path
+                new_paths.insert(new_paths.end(), std::make_move_iterator(this->paths.begin()), std::make_move_iterator(path));  // not including this path
             
                 // finally we add the first half of current path
                 {
-                    ExtrusionPath p = *path;
-                    p.polyline.points.erase(p.polyline.points.begin() + idx + 1, p.polyline.points.end());
-                    if (p.polyline.is_valid()) new_paths.push_back(p);
+                    path->polyline.points.erase(path->polyline.points.begin() + idx + 1, path->polyline.points.end());
+                    if (path->polyline.is_valid()) new_paths.emplace_back(std::move(*path));
                 }
                 // we can now override the old path list with the new one and stop looping
                 std::swap(this->paths, new_paths);
@@ -1,4 +1,5 @@
 #include "../ClipperUtils.hpp"
+#include "../PolygonTrimmer.hpp"
 #include "../PolylineCollection.hpp"
 #include "../Surface.hpp"
 
@@ -162,7 +163,7 @@ void Fill3DHoneycomb::_fill_surface_single(
         it->translate(bb.min(0), bb.min(1));
 
     // clip pattern to boundaries
-    polylines = intersection_pl(polylines, (Polygons)expolygon);
+    polylines = trim_polylines(polylines, expolygon);
 
     // connect lines
     if (! params.dont_connect && ! polylines.empty()) { // prevent calling leftmost_point() on empty collections
@@ -1,4 +1,5 @@
 #include "../ClipperUtils.hpp"
+#include "../PolygonTrimmer.hpp"
 #include "../PolylineCollection.hpp"
 #include "../Surface.hpp"
 
@@ -44,7 +45,7 @@ void FillPlanePath::_fill_surface_single(
                 coord_t(floor((*it)(0) * distance_between_lines + 0.5)), 
                 coord_t(floor((*it)(1) * distance_between_lines + 0.5))));
 //      intersection(polylines_src, offset((Polygons)expolygon, scale_(0.02)), &polylines);
-        polylines = intersection_pl(polylines, to_polygons(expolygon));
+        polylines = trim_polylines(polylines, expolygon);
 
 /*        
         if (1) {
@@ -2281,9 +2281,11 @@ namespace Slic3r {
         sprintf(buffer, "; %s\n\n", header_slic3r_generated().c_str());
         std::string out = buffer;
 
-        for (const std::string &key : config.keys())
-            if (key != "compatible_printers")
-                out += "; " + key + " = " + config.opt_serialize(key) + "\n";
+        // Most of the config does not change between the exports, reuse the serialized values.
+        static ConfigSerializationCache serialization_cache;
+        serialization_cache.append_config_block(config,
+            [](const t_config_option_key &key, const ConfigOption&) { return key != "compatible_printers"; },
+            out);
 
         if (!out.empty())
         {
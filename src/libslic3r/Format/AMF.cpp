@@ -947,9 +947,11 @@ bool store_amf(const char *path, Model *model, const DynamicPrintConfig *config)
     if (config != nullptr)
     {
         std::string str_config = "\n";
-        for (const std::string &key : config->keys())
-            if (key != "compatible_printers")
-                str_config += "; " + key + " = " + config->opt_serialize(key) + "\n";
+        // Most of the config does not change between the exports, reuse the serialized values.
+        static ConfigSerializationCache serialization_cache;
+        serialization_cache.append_config_block(*config,
+            [](const t_config_option_key &key, const ConfigOption&) { return key != "compatible_printers"; },
+            str_config);
         stream << "<metadata type=\"" << SLIC3R_CONFIG_TYPE << "\">" << xml_escape(str_config) << "</metadata>\n";
     }
 
@@ -296,8 +296,6 @@ std::string WipeTowerIntegration::append_tcr(GCode &gcodegen, const WipeTower::T
     Vec2f wipe_tower_offset = tcr.priming ? Vec2f::Zero() : m_wipe_tower_pos;
     float wipe_tower_rotation = tcr.priming ? 0.f : alpha;
 
-    std::string tcr_rotated_gcode = post_process_wipe_tower_moves(tcr, wipe_tower_offset, wipe_tower_rotation);
-
     if (!tcr.priming) {
         // Move over the wipe tower.
         // Retract for a tool change, using the toolchange retract value and setting the priming extra length.
@@ -363,13 +361,8 @@ std::string WipeTowerIntegration::append_tcr(GCode &gcodegen, const WipeTower::T
     }
 
     // Insert the end filament, toolchange, and start filament gcode into the generated gcode.
-    DynamicConfig config;
-    config.set_key_value("end_filament_gcode",   new ConfigOptionString(end_filament_gcode_str));
-    config.set_key_value("toolchange_gcode",     new ConfigOptionString(toolchange_gcode_str));
-    config.set_key_value("start_filament_gcode", new ConfigOptionString(start_filament_gcode_str));
-    std::string tcr_gcode, tcr_escaped_gcode = gcodegen.placeholder_parser_process("tcr_rotated_gcode", tcr_rotated_gcode, new_extruder_id, &config);
-    unescape_string_cstyle(tcr_escaped_gcode, tcr_gcode);
-    gcode += tcr_gcode;
+    gcode += post_process_wipe_tower_moves(tcr, wipe_tower_offset, wipe_tower_rotation, 
+        end_filament_gcode_str, toolchange_gcode_str, start_filament_gcode_str);
     check_add_eol(toolchange_gcode_str);
 
 
@@ -393,71 +386,81 @@ std::string WipeTowerIntegration::append_tcr(GCode &gcodegen, const WipeTower::T
     return gcode;
 }
 
-// This function postprocesses gcode_original, rotates and moves all G1 extrusions and returns resulting gcode
+// This function formats the G-code of a tool change, rotates and moves all G1 extrusions and fills in the custom G-code sections.
 // Starting position has to be supplied explicitely (otherwise it would fail in case first G1 command only contained one coordinate)
-std::string WipeTowerIntegration::post_process_wipe_tower_moves(const WipeTower::ToolChangeResult& tcr, const Vec2f& translation, float angle) const
+std::string WipeTowerIntegration::post_process_wipe_tower_moves(const WipeTower::ToolChangeResult& tcr, const Vec2f& translation, float angle,
+    const std::string &end_filament_gcode, const std::string &toolchange_gcode, const std::string &start_filament_gcode) const
 {
     Vec2f extruder_offset = m_extruder_offsets[tcr.initial_tool].cast<float>();
 
-    std::istringstream gcode_str(tcr.gcode);
+    const Eigen::Rotation2Df rotation(angle);
     std::string gcode_out;
-    std::string line;
+    gcode_out.reserve(tcr.gcode.text.size() + 32 * tcr.gcode.lines.size() + 
+        end_filament_gcode.size() + toolchange_gcode.size() + start_filament_gcode.size());
     Vec2f pos = tcr.start_pos;
     Vec2f transformed_pos = pos;
     Vec2f old_pos(-1000.1f, -1000.1f);
+    // The custom G-code sections are unescaped the same way as if they were inserted by the placeholder parser.
+    auto append_custom_gcode = [&gcode_out](const std::string &custom_gcode) {
+        std::string unescaped;
+        unescape_string_cstyle(custom_gcode, unescaped);
+        gcode_out += unescaped;
+    };
 
-    while (gcode_str) {
-        std::getline(gcode_str, line);  // we read the gcode line by line
-
-        // All G1 commands should be translated and rotated
-        if (line.find("G1 ") == 0) {
-            std::ostringstream line_out;
-            std::istringstream line_str(line);
-            line_str >> std::noskipws;  // don't skip whitespace
-            char ch = 0;
-            while (line_str >> ch) {
-                if (ch == 'X')
-                    line_str >> pos.x();
-                else
-                    if (ch == 'Y')
-                        line_str >> pos.y();
-                    else
-                        line_out << ch;
-            }
-
-            transformed_pos = pos;
-            transformed_pos = Eigen::Rotation2Df(angle) * transformed_pos;
-            transformed_pos += translation;
-
-            if (transformed_pos != old_pos) {
-                line = line_out.str();
-                std::ostringstream oss;
-                oss << std::fixed << std::setprecision(3) << "G1 ";
-                if (transformed_pos.x() != old_pos.x())
-                    oss << " X" << transformed_pos.x() - extruder_offset.x();
-                if (transformed_pos.y() != old_pos.y())
-                    oss << " Y" << transformed_pos.y() - extruder_offset.y();
-
-                line.replace(line.find("G1 "), 3, oss.str());
-                old_pos = transformed_pos;
+    for (const WipeTower::GCodeLine &line : tcr.gcode.lines) {
+        switch (line.type) {
+        case WipeTower::GCodeLine::Move:
+        {
+            // All G1 commands should be translated and rotated
+            if (line.flags & WipeTower::GCodeLine::HasX)
+                pos.x() = line.x;
+            if (line.flags & WipeTower::GCodeLine::HasY)
+                pos.y() = line.y;
+            transformed_pos = rotation * pos + translation;
+
+            char  buf[128];
+            char *ptr = buf;
+            memcpy(ptr, "G1", 2);
+            ptr += 2;
+            bool never_skip = (line.flags & WipeTower::GCodeLine::NeverSkip) != 0;
+            if (never_skip || transformed_pos.x() != old_pos.x())
+                ptr += sprintf(ptr, " X%.3f", transformed_pos.x() - extruder_offset.x());
+            if (never_skip || transformed_pos.y() != old_pos.y())
+                ptr += sprintf(ptr, " Y%.3f", transformed_pos.y() - extruder_offset.y());
+            old_pos = transformed_pos;
+            if (line.flags & WipeTower::GCodeLine::HasZ)
+                ptr += sprintf(ptr, " Z%.3f", line.z);
+            if (line.flags & WipeTower::GCodeLine::HasE)
+                ptr += sprintf(ptr, " E%.4f", line.e);
+            if (line.flags & WipeTower::GCodeLine::HasF)
+                ptr += sprintf(ptr, " F%d", int(floor(line.f + 0.5f)));
+            // Skip a G1 without any axis, if the position did not change.
+            if (ptr - buf > 2) {
+                *ptr ++ = '\n';
+                gcode_out.append(buf, ptr - buf);
             }
+            break;
         }
-
-        gcode_out += line + "\n";
-
-        // If this was a toolchange command, we should change current extruder offset
-        if (line == "[toolchange_gcode]") {
+        case WipeTower::GCodeLine::Text:
+            gcode_out.append(tcr.gcode.text, line.text_begin, line.text_end - line.text_begin);
+            break;
+        case WipeTower::GCodeLine::EndFilamentGCode:
+            append_custom_gcode(end_filament_gcode);
+            break;
+        case WipeTower::GCodeLine::ToolchangeGCode:
+            append_custom_gcode(toolchange_gcode);
+            // After the toolchange, we should change current extruder offset
             extruder_offset = m_extruder_offsets[tcr.new_tool].cast<float>();
-
             // If the extruder offset changed, add an extra move so everything is continuous
             if (extruder_offset != m_extruder_offsets[tcr.initial_tool].cast<float>()) {
-                std::ostringstream oss;
-                oss << std::fixed << std::setprecision(3)
-                    << "G1 X" << transformed_pos.x() - extruder_offset.x()
-                    << " Y"   << transformed_pos.y() - extruder_offset.y()
-                    << "\n";
-                gcode_out += oss.str();
+                char buf[128];
+                int  len = sprintf(buf, "G1 X%.3f Y%.3f\n", transformed_pos.x() - extruder_offset.x(), transformed_pos.y() - extruder_offset.y());
+                gcode_out.append(buf, len);
             }
+            break;
+        case WipeTower::GCodeLine::StartFilamentGCode:
+            append_custom_gcode(start_filament_gcode);
+            break;
         }
     }
     return gcode_out;
@@ -1958,10 +1961,10 @@ void GCode::apply_print_config(const PrintConfig &print_config)
 
 void GCode::append_full_config(const Print &print, std::string &str)
 {
-	const DynamicPrintConfig &cfg = print.full_print_config();
-    for (const std::string &key : cfg.keys())
-        if (key != "compatible_prints" && key != "compatible_printers" && ! cfg.option(key)->is_nil())
-            str += "; " + key + " = " + cfg.opt_serialize(key) + "\n";
+    // The serialized values are cached by the Print, so that only the options modified since the last export are serialized again.
+    print.config_serialization_cache().append_config_block(print.full_print_config(),
+        [](const t_config_option_key &key, const ConfigOption &opt) { return key != "compatible_prints" && key != "compatible_printers" && ! opt.is_nil(); },
+        str);
 }
 
 void GCode::set_extruders(const std::vector<unsigned int> &extruder_ids)
@@ -2223,10 +2226,12 @@ std::vector<float> polygon_angles_at_vertices(const Polygon &polygon, const std:
     return angles;
 }
 
-std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, double speed, std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid)
+std::string GCode::extrude_loop(const ExtrusionLoop &loop_src, std::string description, double speed, std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid)
 {
     // get a copy; don't modify the orientation of the original loop object otherwise
-    // next copies (if any) would not detect the correct orientation
+    // next copies (if any) would not detect the correct orientation.
+    // This is the only copy made: it is split, clipped and simplified in place.
+    ExtrusionLoop loop(loop_src);
 
     if (m_layer->lower_layer != nullptr && lower_layer_edge_grid != nullptr) {
         if (! *lower_layer_edge_grid) {
@@ -2428,12 +2433,24 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
         0;
 
     // get paths
-    ExtrusionPaths paths;
-    loop.clip_end(clip_length, &paths);
+    // Length of the loop before clipping, as ExtrusionLoop::clip_end() would leave the loop intact.
+    double         loop_length = loop.length();
+    ExtrusionPaths &paths      = loop.paths;
+    for (double distance = clip_length; distance > 0 && ! paths.empty();) {
+        ExtrusionPath &last = paths.back();
+        double len = last.length();
+        if (len <= distance) {
+            paths.pop_back();
+            distance -= len;
+        } else {
+            last.polyline.clip_end(distance);
+            break;
+        }
+    }
     if (paths.empty()) return "";
     
     // apply the small perimeter speed
-    if (is_perimeter(paths.front().role()) && loop.length() <= SMALL_PERIMETER_LENGTH && speed == -1)
+    if (is_perimeter(paths.front().role()) && loop_length <= SMALL_PERIMETER_LENGTH && speed == -1)
         speed = m_config.small_perimeter_speed.get_abs_value(m_config.perimeter_speed);
     
     // extrude along the path
@@ -2448,9 +2465,6 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
     // reset acceleration
     gcode += m_writer.set_acceleration((unsigned int)(m_config.default_acceleration.value + 0.5));
     
-    if (m_wipe.enable)
-        m_wipe.path = paths.front().polyline;  // TODO: don't limit wipe to last path
-    
     // make a little move inwards before leaving loop
 	if (paths.back().role() == erExternalPerimeter && m_layer != NULL && m_config.perimeters.value > 1 && paths.front().size() >= 2 && paths.back().polyline.points.size() >= 3) {
         // detect angle between last and first segment
@@ -2484,23 +2498,43 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
         // generate the travel move
         gcode += m_writer.travel_to_xy(this->point_to_gcode(pt), "move inwards before travel");
     }
+
+    if (m_wipe.enable)
+        // The working copy is not needed anymore, steal its polyline.
+        m_wipe.path = std::move(paths.front().polyline);  // TODO: don't limit wipe to last path
     
     return gcode;
 }
 
-std::string GCode::extrude_multi_path(ExtrusionMultiPath multipath, std::string description, double speed)
+// Simplified copy of a borrowed extrusion path, reversed if asked for.
+// Only the simplified polyline is allocated, the source path is not copied unless it is to be reversed.
+static ExtrusionPath simplified_extrusion_path(const ExtrusionPath &path, bool reversed)
+{
+    ExtrusionPath out(path.role(), path.mm3_per_mm, path.width, path.height);
+    out.feedrate    = path.feedrate;
+    out.extruder_id = path.extruder_id;
+    out.cp_color_id = path.cp_color_id;
+    // Reverse before simplification to produce exactly the points of path.reverse(); path.simplify().
+    out.polyline.points = reversed ?
+        MultiPoint::_douglas_peucker(Points(path.polyline.points.rbegin(), path.polyline.points.rend()), SCALED_RESOLUTION) :
+        MultiPoint::_douglas_peucker(path.polyline.points, SCALED_RESOLUTION);
+    return out;
+}
+
+std::string GCode::extrude_multi_path(const ExtrusionMultiPath &multipath, std::string description, double speed, bool reversed)
 {
     // extrude along the path
     std::string gcode;
-    for (ExtrusionPath path : multipath.paths) {
+    for (size_t i = 0; i < multipath.paths.size(); ++ i) {
 //    description += ExtrusionLoopRole2String(loop.loop_role());
 //    description += ExtrusionRole2String(path->role);
-        path.simplify(SCALED_RESOLUTION);
-        gcode += this->_extrude(path, description, speed);
+        gcode += this->_extrude(simplified_extrusion_path(multipath.paths[reversed ? multipath.paths.size() - i - 1 : i], reversed), description, speed);
     }
     if (m_wipe.enable) {
-        m_wipe.path = std::move(multipath.paths.back().polyline);  // TODO: don't limit wipe to last path
-        m_wipe.path.reverse();
+        // Wipe along the last extruded path before simplification, reversed.
+        m_wipe.path = reversed ? multipath.paths.front().polyline : multipath.paths.back().polyline;  // TODO: don't limit wipe to last path
+        if (! reversed)
+            m_wipe.path.reverse();
     }
     // reset acceleration
     gcode += m_writer.set_acceleration((unsigned int)floor(m_config.default_acceleration.value + 0.5));
@@ -2521,10 +2555,10 @@ std::string GCode::extrude_entity(const ExtrusionEntity &entity, std::string des
     }
 }
 
-std::string GCode::extrude_path(ExtrusionPath path, std::string description, double speed)
+std::string GCode::extrude_path(const ExtrusionPath &path_src, std::string description, double speed, bool reversed)
 {
 //    description += ExtrusionRole2String(path.role());
-    path.simplify(SCALED_RESOLUTION);
+    ExtrusionPath path = simplified_extrusion_path(path_src, reversed);
     std::string gcode = this->_extrude(path, description, speed);
     if (m_wipe.enable) {
         m_wipe.path = std::move(path.polyline);
@@ -2535,13 +2569,59 @@ std::string GCode::extrude_path(ExtrusionPath path, std::string description, dou
     return gcode;
 }
 
+// Greedy chaining of borrowed extrusion entities to minimize travel, visiting the entities in the same order
+// and with the same orientation as ExtrusionEntityCollection::chained_path_from() would, however without cloning
+// and reversing the entities. If reversed, the entities are chained as if ExtrusionEntityCollection::reverse()
+// was called on their collection first.
+// Returns pairs of an index into entities and whether the entity is to be extruded reversed.
+template<typename ExtrusionEntityPtrs>
+static std::vector<std::pair<size_t, bool>> chain_extrusion_entities(const ExtrusionEntityPtrs &entities, Point start_near, bool reversed = false, bool no_sort = false)
+{
+    std::vector<std::pair<size_t, bool>> todo;
+    todo.reserve(entities.size());
+    for (size_t i = 0; i < entities.size(); ++ i) {
+        size_t idx = reversed ? entities.size() - i - 1 : i;
+        // ExtrusionEntityCollection::reverse() does not reverse loops.
+        todo.emplace_back(idx, reversed && ! entities[idx]->is_loop());
+    }
+    if (no_sort)
+        return todo;
+
+    Points endpoints;
+    endpoints.reserve(2 * todo.size());
+    for (const std::pair<size_t, bool> &item : todo) {
+        const ExtrusionEntity *ee = entities[item.first];
+        Point first_point = item.second ? ee->last_point() : ee->first_point();
+        endpoints.emplace_back(first_point);
+        endpoints.emplace_back(ee->can_reverse() ? (item.second ? ee->first_point() : ee->last_point()) : first_point);
+    }
+
+    std::vector<std::pair<size_t, bool>> out;
+    out.reserve(todo.size());
+    while (! todo.empty()) {
+        // find nearest point
+        int start_index = start_near.nearest_point_index(endpoints);
+        int path_index  = start_index / 2;
+        std::pair<size_t, bool> item = todo[path_index];
+        const ExtrusionEntity  *ee   = entities[item.first];
+        // never reverse loops, since it's pointless for chained path and callers might depend on orientation
+        if ((start_index % 2) && ee->can_reverse())
+            item.second = ! item.second;
+        out.emplace_back(item);
+        todo.erase(todo.begin() + path_index);
+        endpoints.erase(endpoints.begin() + 2 * path_index, endpoints.begin() + 2 * path_index + 2);
+        start_near = item.second ? ee->first_point() : ee->last_point();
+    }
+    return out;
+}
+
 // Extrude perimeters: Decide where to put seams (hide or align seams).
 std::string GCode::extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, std::unique_ptr<EdgeGrid::Grid> &lower_layer_edge_grid)
 {
     std::string gcode;
     for (const ObjectByExtruder::Island::Region &region : by_region) {
         m_config.apply(print.regions()[&region - &by_region.front()]->config());
-        for (ExtrusionEntity *ee : region.perimeters.entities)
+        for (const ExtrusionEntity *ee : region.perimeters)
             gcode += this->extrude_entity(*ee, "perimeter", -1., &lower_layer_edge_grid);
     }
     return gcode;
@@ -2551,17 +2631,24 @@ std::string GCode::extrude_perimeters(const Print &print, const std::vector<Obje
 std::string GCode::extrude_infill(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region)
 {
     std::string gcode;
+    auto extrude_chained = [this, &gcode](const ExtrusionEntity &entity, bool reversed) {
+        if (const ExtrusionPath *path = dynamic_cast<const ExtrusionPath*>(&entity))
+            gcode += this->extrude_path(*path, "infill", -1., reversed);
+        else if (const ExtrusionMultiPath *multipath = dynamic_cast<const ExtrusionMultiPath*>(&entity))
+            gcode += this->extrude_multi_path(*multipath, "infill", -1., reversed);
+        else
+            // Loops are never reversed by chaining.
+            gcode += this->extrude_entity(entity, "infill");
+    };
     for (const ObjectByExtruder::Island::Region &region : by_region) {
         m_config.apply(print.regions()[&region - &by_region.front()]->config());
-		ExtrusionEntityCollection chained = region.infills.chained_path_from(m_last_pos, false);
-        for (ExtrusionEntity *fill : chained.entities) {
-            auto *eec = dynamic_cast<ExtrusionEntityCollection*>(fill);
-            if (eec) {
-				ExtrusionEntityCollection chained2 = eec->chained_path_from(m_last_pos, false);
-				for (ExtrusionEntity *ee : chained2.entities)
-                    gcode += this->extrude_entity(*ee, "infill");
+        for (const std::pair<size_t, bool> &fill : chain_extrusion_entities(region.infills, m_last_pos)) {
+            const ExtrusionEntity *entity = region.infills[fill.first];
+            if (auto *eec = dynamic_cast<const ExtrusionEntityCollection*>(entity)) {
+                for (const std::pair<size_t, bool> &ee : chain_extrusion_entities(eec->entities, m_last_pos, fill.second, eec->no_sort))
+                    extrude_chained(*eec->entities[ee.first], ee.second);
             } else
-                gcode += this->extrude_entity(*fill, "infill");
+                extrude_chained(*entity, fill.second);
         }
     }
     return gcode;
@@ -3031,8 +3118,8 @@ const std::vector<GCode::ObjectByExtruder::Island::Region>& GCode::ObjectByExtru
         // Now we are going to iterate through perimeters and infills and pick ones that are supposed to be printed
         // References are used so that we don't have to repeat the same code
         for (int iter = 0; iter < 2; ++iter) {
-            const ExtrusionEntitiesPtr&         entities     = (iter ? reg.infills.entities : reg.perimeters.entities);
-            ExtrusionEntityCollection&          target_eec   = (iter ? by_region_per_copy_cache.back().infills : by_region_per_copy_cache.back().perimeters);
+            const std::vector<const ExtrusionEntity*>& entities    = (iter ? reg.infills : reg.perimeters);
+            std::vector<const ExtrusionEntity*>&       target_eec  = (iter ? by_region_per_copy_cache.back().infills : by_region_per_copy_cache.back().perimeters);
             const std::vector<const ExtruderPerCopy*>& overrides   = (iter ? reg.infills_overrides : reg.perimeters_overrides);
 
             // Now the most important thing - which extrusion should we print.
@@ -3041,7 +3128,7 @@ const std::vector<GCode::ObjectByExtruder::Island::Region>& GCode::ObjectByExtru
 
             for (unsigned int i=0;i<entities.size();++i)
                 if (overrides[i]->at(copy) == this_extruder_mark)   // this copy should be printed with this extruder
-                    target_eec.append((*entities[i]));
+                    target_eec.emplace_back(entities[i]);
         }
     }
     return by_region_per_copy_cache;
@@ -3050,11 +3137,12 @@ const std::vector<GCode::ObjectByExtruder::Island::Region>& GCode::ObjectByExtru
 
 
 // This function takes the eec and appends its entities to either perimeters or infills of this Region (depending on the first parameter)
+// The entities are borrowed, not cloned.
 // It also saves pointer to ExtruderPerCopy struct (for each entity), that holds information about which extruders should be used for which copy.
 void GCode::ObjectByExtruder::Island::Region::append(const std::string& type, const ExtrusionEntityCollection* eec, const ExtruderPerCopy* copies_extruder, unsigned int object_copies_num)
 {
     // We are going to manipulate either perimeters or infills, exactly in the same way. Let's create pointers to the proper structure to not repeat ourselves:
-    ExtrusionEntityCollection* perimeters_or_infills = &infills;
+    std::vector<const ExtrusionEntity*>* perimeters_or_infills = &infills;
     std::vector<const ExtruderPerCopy*>* perimeters_or_infills_overrides = &infills_overrides;
 
     if (type == "perimeters") {
@@ -3069,7 +3157,7 @@ void GCode::ObjectByExtruder::Island::Region::append(const std::string& type, co
 
 
     // First we append the entities, there are eec->entities.size() of them:
-    perimeters_or_infills->append(eec->entities);
+    perimeters_or_infills->insert(perimeters_or_infills->end(), eec->entities.begin(), eec->entities.end());
 
     for (unsigned int i=0;i<eec->entities.size();++i)
         perimeters_or_infills_overrides->push_back(copies_extruder);
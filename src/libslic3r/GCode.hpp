@@ -112,8 +112,9 @@ private:
     WipeTowerIntegration& operator=(const WipeTowerIntegration&);
     std::string append_tcr(GCode &gcodegen, const WipeTower::ToolChangeResult &tcr, int new_extruder_id) const;
 
-    // Postprocesses gcode: rotates and moves G1 extrusions and returns result
-    std::string post_process_wipe_tower_moves(const WipeTower::ToolChangeResult& tcr, const Vec2f& translation, float angle) const;
+    // Formats the G-code of a tool change: rotates and moves G1 extrusions and fills in the custom G-code sections.
+    std::string post_process_wipe_tower_moves(const WipeTower::ToolChangeResult& tcr, const Vec2f& translation, float angle,
+        const std::string &end_filament_gcode, const std::string &toolchange_gcode, const std::string &start_filament_gcode) const;
 
     // Left / right edges of the wipe tower, for the planning of wipe moves.
     const float                                                  m_left;
@@ -221,9 +222,10 @@ protected:
     std::string     preamble();
     std::string     change_layer(coordf_t print_z);
     std::string     extrude_entity(const ExtrusionEntity &entity, std::string description = "", double speed = -1., std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
-    std::string     extrude_loop(ExtrusionLoop loop, std::string description, double speed = -1., std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
-    std::string     extrude_multi_path(ExtrusionMultiPath multipath, std::string description = "", double speed = -1.);
-    std::string     extrude_path(ExtrusionPath path, std::string description = "", double speed = -1.);
+    std::string     extrude_loop(const ExtrusionLoop &loop, std::string description, double speed = -1., std::unique_ptr<EdgeGrid::Grid> *lower_layer_edge_grid = nullptr);
+    // The multi-path / path are only borrowed. If reversed, they are extruded as if reverse() was called on them.
+    std::string     extrude_multi_path(const ExtrusionMultiPath &multipath, std::string description = "", double speed = -1., bool reversed = false);
+    std::string     extrude_path(const ExtrusionPath &path, std::string description = "", double speed = -1., bool reversed = false);
 
     typedef std::vector<int> ExtruderPerCopy;
     // Extruding multiple objects with soluble / non-soluble / combined supports
@@ -239,8 +241,9 @@ protected:
         struct Island
         {
             struct Region {
-                ExtrusionEntityCollection perimeters;
-                ExtrusionEntityCollection infills;
+                // Extrusion entities borrowed from the layer regions of the print object, which outlive the G-code export of a layer.
+                std::vector<const ExtrusionEntity*> perimeters;
+                std::vector<const ExtrusionEntity*> infills;
 
                 std::vector<const ExtruderPerCopy*> infills_overrides;
                 std::vector<const ExtruderPerCopy*> perimeters_overrides;
@@ -5,6 +5,9 @@
 #include <boost/format.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/nowide/convert.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include "../Utils.hpp"
 
 #ifdef WIN32
 
@@ -139,7 +142,9 @@ static int run_script(const std::string &script, const std::string &gcode, std::
 
 #include <cstdlib>   // getenv()
 #include <sstream>
+#include <fcntl.h>
 #include <boost/process.hpp>
+#include <boost/nowide/fstream.hpp>
 
 namespace process = boost::process;
 
@@ -175,10 +180,112 @@ static int run_script(const std::string &script, const std::string &gcode, std::
     return child.exit_code();
 }
 
+// Chain the scripts as stdin -> stdout filters, feed them with src_path and write the output of the last one to dst_path.
+// The filters run concurrently. Returns the index of the failed script or -1, fills in its exit code and error output.
+static int run_filters(const std::vector<std::string> &scripts, const std::string &src_path, const std::string &dst_path, int &result, std::string &std_err)
+{
+    const char *shell = ::getenv("SHELL");
+    if (shell == nullptr) { shell = "sh"; }
+
+    // Open the files the same way the G-code export does, the filters only inherit the descriptors.
+    FILE *src = boost::nowide::fopen(src_path.c_str(), "rb");
+    if (src == nullptr)
+        throw std::runtime_error(std::string("Post-processor can't open file ") + src_path);
+    FILE *dst = boost::nowide::fopen(dst_path.c_str(), "wb");
+    if (dst == nullptr) {
+        fclose(src);
+        throw std::runtime_error(std::string("Post-processor can't open file ") + dst_path + " for writing");
+    }
+
+    // Error output of the filters is collected into temporary files, so that a filter filling in its stderr pipe
+    // could not block the whole chain.
+    std::vector<boost::filesystem::path> std_err_paths;
+    std::vector<process::child>          children;
+    std::unique_ptr<process::pipe>       pipe_in;
+    children.reserve(scripts.size());
+    try {
+        for (size_t i = 0; i < scripts.size(); ++ i) {
+            BOOST_LOG_TRIVIAL(debug) << boost::format("Executing filter, shell: %1%, command: %2%") % shell % scripts[i];
+            std_err_paths.emplace_back(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(".post_process.%%%%-%%%%-%%%%-%%%%.log"));
+            std::unique_ptr<process::pipe> pipe_out;
+            if (i + 1 < scripts.size()) {
+                pipe_out.reset(new process::pipe());
+                // Don't let the other filters inherit the pipe, otherwise the reader would never see the end of file.
+                ::fcntl(pipe_out->native_source(), F_SETFD, FD_CLOEXEC);
+                ::fcntl(pipe_out->native_sink(),   F_SETFD, FD_CLOEXEC);
+            }
+            const boost::filesystem::path &err = std_err_paths.back();
+            if (! pipe_in && ! pipe_out)
+                children.emplace_back(shell, "-c", scripts[i], process::std_in < src, process::std_out > dst, process::std_err > err);
+            else if (! pipe_in)
+                children.emplace_back(shell, "-c", scripts[i], process::std_in < src, process::std_out > *pipe_out, process::std_err > err);
+            else if (! pipe_out)
+                children.emplace_back(shell, "-c", scripts[i], process::std_in < *pipe_in, process::std_out > dst, process::std_err > err);
+            else
+                children.emplace_back(shell, "-c", scripts[i], process::std_in < *pipe_in, process::std_out > *pipe_out, process::std_err > err);
+            // The pipe is owned by the two filters now.
+            pipe_in = std::move(pipe_out);
+        }
+    } catch (...) {
+        // The filters already started are terminated by the destructors of their process::child.
+        fclose(src);
+        fclose(dst);
+        throw;
+    }
+    fclose(src);
+    fclose(dst);
+
+    int failed = -1;
+    for (size_t i = 0; i < children.size(); ++ i) {
+        children[i].wait();
+        // A filter failing in the middle of the chain breaks the pipe of the filters before it,
+        // therefore the last failed filter is the one to report.
+        if (children[i].exit_code() != 0) {
+            failed = int(i);
+            result = children[i].exit_code();
+        }
+    }
+    if (failed != -1) {
+        boost::nowide::ifstream ifs(std_err_paths[failed].string());
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        std_err = ss.str();
+    }
+    for (const boost::filesystem::path &path : std_err_paths) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    }
+    return failed;
+}
+
 #endif
 
 namespace Slic3r {
 
+static std::vector<std::string> post_process_scripts(const PrintConfig &config)
+{
+    std::vector<std::string> out;
+    for (const std::string &scripts : config.post_process.values) {
+		std::vector<std::string> lines;
+		boost::split(lines, scripts, boost::is_any_of("\r\n"));
+        for (std::string script : lines) {
+            // Ignore empty post processing script lines.
+            boost::trim(script);
+            if (! script.empty())
+                out.emplace_back(std::move(script));
+        }
+    }
+    return out;
+}
+
+static void throw_script_failed(const std::string &script, const std::string &path, int result, const std::string &std_err)
+{
+    const std::string msg = std_err.empty() ? (boost::format("Post-processing script %1% on file %2% failed.\nError code: %3%") % script % path % result).str()
+        : (boost::format("Post-processing script %1% on file %2% failed.\nError code: %3%\nOutput:\n%4%") % script % path % result % std_err).str();
+    BOOST_LOG_TRIVIAL(error) << msg;
+    throw std::runtime_error(msg);
+}
+
 void run_post_process_scripts(const std::string &path, const PrintConfig &config)
 {
     if (config.post_process.values.empty())
@@ -189,26 +296,42 @@ void run_post_process_scripts(const std::string &path, const PrintConfig &config
     if (! boost::filesystem::exists(gcode_file))
         throw std::runtime_error(std::string("Post-processor can't find exported gcode file"));
 
-    for (const std::string &scripts : config.post_process.values) {
-		std::vector<std::string> lines;
-		boost::split(lines, scripts, boost::is_any_of("\r\n"));
-        for (std::string script : lines) {
-            // Ignore empty post processing script lines.
-            boost::trim(script);
-            if (script.empty())
-                continue;
-            BOOST_LOG_TRIVIAL(info) << "Executing script " << script << " on file " << path;
-
-            std::string std_err;
-            const int result = run_script(script, gcode_file.string(), std_err);
-            if (result != 0) {
-                const std::string msg = std_err.empty() ? (boost::format("Post-processing script %1% on file %2% failed.\nError code: %3%") % script % path % result).str()
-                    : (boost::format("Post-processing script %1% on file %2% failed.\nError code: %3%\nOutput:\n%4%") % script % path % result % std_err).str();
-                BOOST_LOG_TRIVIAL(error) << msg;
-                throw std::runtime_error(msg);
-            }
-        }
+    for (const std::string &script : post_process_scripts(config)) {
+        BOOST_LOG_TRIVIAL(info) << "Executing script " << script << " on file " << path;
+        std::string std_err;
+        const int result = run_script(script, gcode_file.string(), std_err);
+        if (result != 0)
+            throw_script_failed(script, path, result, std_err);
     }
 }
 
+bool post_process_streaming(const PrintConfig &config)
+{
+#ifdef WIN32
+    // The filters are not implemented on Windows, the scripts are run on the exported file.
+    return false;
+#else
+    return config.post_process_streaming.value && ! post_process_scripts(config).empty();
+#endif
+}
+
+void run_post_process_scripts(const std::string &src_path, const std::string &dst_path, const PrintConfig &config)
+{
+    assert(post_process_streaming(config));
+#ifndef WIN32
+    std::vector<std::string> scripts = post_process_scripts(config);
+    if (! boost::filesystem::exists(boost::filesystem::path(src_path)))
+        throw std::runtime_error(std::string("Post-processor can't find exported gcode file"));
+    config.setenv_();
+    BOOST_LOG_TRIVIAL(info) << "Piping file " << src_path << " through " << scripts.size() << " post-processing scripts to file " << dst_path;
+    int         result = 0;
+    std::string std_err;
+    int         failed = run_filters(scripts, src_path, dst_path, result, std_err);
+    if (failed != -1) {
+        boost::nowide::remove(dst_path.c_str());
+        throw_script_failed(scripts[failed], dst_path, result, std_err);
+    }
+#endif
+}
+
 } // namespace Slic3r
@@ -8,7 +8,14 @@
 
 namespace Slic3r {
 
+// Run the post-processing scripts one after the other, each script is passed the path to the G-code file to modify in place.
 extern void run_post_process_scripts(const std::string &path, const PrintConfig &config);
+// Are the post-processing scripts to be chained as stdin -> stdout filters? True if post_process_streaming is enabled,
+// there is a script to run and the platform supports it.
+extern bool post_process_streaming(const PrintConfig &config);
+// Export the G-code file src_path to dst_path through the post-processing scripts chained as stdin -> stdout filters
+// running concurrently, so that the output is written to dst_path just once. Only call if post_process_streaming(config).
+extern void run_post_process_scripts(const std::string &src_path, const std::string &dst_path, const PrintConfig &config);
 
 } // namespace Slic3r
 
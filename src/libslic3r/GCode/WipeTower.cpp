@@ -66,18 +66,18 @@ public:
         {
             // adds tag for analyzer:
             char buf[64];
-            sprintf(buf, ";%s%f\n", GCodeAnalyzer::Height_Tag.c_str(), m_layer_height); // don't rely on GCodeAnalyzer knowing the layer height - it knows nothing at priming
-            m_gcode += buf;
-            sprintf(buf, ";%s%d\n", GCodeAnalyzer::Extrusion_Role_Tag.c_str(), erWipeTower);
-            m_gcode += buf;
+            int len = sprintf(buf, ";%s%f\n", GCodeAnalyzer::Height_Tag.c_str(), m_layer_height); // don't rely on GCodeAnalyzer knowing the layer height - it knows nothing at priming
+            m_gcode.append_text(buf, len);
+            len = sprintf(buf, ";%s%d\n", GCodeAnalyzer::Extrusion_Role_Tag.c_str(), erWipeTower);
+            m_gcode.append_text(buf, len);
             change_analyzer_line_width(line_width);
         }
 
     WipeTowerWriter&              change_analyzer_line_width(float line_width) {
             // adds tag for analyzer:
             char buf[64];
-            sprintf(buf, ";%s%f\n", GCodeAnalyzer::Width_Tag.c_str(), line_width);
-            m_gcode += buf;
+            int len = sprintf(buf, ";%s%f\n", GCodeAnalyzer::Width_Tag.c_str(), line_width);
+            m_gcode.append_text(buf, len);
             return *this;
     }
 
@@ -86,8 +86,8 @@ public:
             float mm3_per_mm = (len == 0.f ? 0.f : area * e / len);
             // adds tag for analyzer:
             char buf[64];
-            sprintf(buf, ";%s%f\n", GCodeAnalyzer::Mm3_Per_Mm_Tag.c_str(), mm3_per_mm);
-            m_gcode += buf;
+            int buf_len = sprintf(buf, ";%s%f\n", GCodeAnalyzer::Mm3_Per_Mm_Tag.c_str(), mm3_per_mm);
+            m_gcode.append_text(buf, buf_len);
             return *this;
     }
 
@@ -115,7 +115,7 @@ public:
     }
 
     WipeTowerWriter&            disable_linear_advance() {
-        m_gcode += (m_gcode_flavor == gcfRepRap ? std::string("M572 D0 S0\n") : std::string("M900 K0\n"));
+        m_gcode.append_text(m_gcode_flavor == gcfRepRap ? std::string("M572 D0 S0\n") : std::string("M900 K0\n"));
         return *this;
     }
 
@@ -127,12 +127,14 @@ public:
 
 	WipeTowerWriter& 			 feedrate(float f)
 	{
-		if (f != m_current_feedrate)
-			m_gcode += "G1" + set_format_F(f) + "\n";
+		if (f != m_current_feedrate) {
+			m_gcode.move(WipeTower::GCodeLine::HasF, 0.f, 0.f, 0.f, 0.f, f);
+			m_current_feedrate = f;
+		}
 		return *this;
 	}
 
-	const std::string&   gcode() const { return m_gcode; }
+	const WipeTower::GCodeLines& gcode() const { return m_gcode; }
 	const std::vector<WipeTower::Extrusion>& extrusions() const { return m_extrusions; }
 	float                x()     const { return m_current_pos.x(); }
 	float                y()     const { return m_current_pos.y(); }
@@ -171,31 +173,33 @@ public:
 			m_extrusions.emplace_back(WipeTower::Extrusion(rot, width, m_current_tool));
 		}
 
-		m_gcode += "G1";
+		unsigned char flags = 0;
 		if (std::abs(rot.x() - rotated_current_pos.x()) > EPSILON)
-			m_gcode += set_format_X(rot.x());
+			flags |= WipeTower::GCodeLine::HasX;
 
 		if (std::abs(rot.y() - rotated_current_pos.y()) > EPSILON)
-			m_gcode += set_format_Y(rot.y());
-
+			flags |= WipeTower::GCodeLine::HasY;
 
 		if (e != 0.f)
-			m_gcode += set_format_E(e);
+			flags |= WipeTower::GCodeLine::HasE;
 
 		if (f != 0.f && f != m_current_feedrate) {
             if (limit_volumetric_flow) {
                 float e_speed = e / (((len == 0) ? std::abs(e) : len) / f * 60.f);
                 f /= std::max(1.f, e_speed / m_filpar[m_current_tool].max_e_speed);
             }
-			m_gcode += set_format_F(f);
+			flags |= WipeTower::GCodeLine::HasF;
+			m_current_feedrate = f;
         }
 
+		if (flags != 0)
+			m_gcode.move(flags, rot.x(), rot.y(), 0.f, e, f);
+
         m_current_pos.x() = x;
         m_current_pos.y() = y;
 
 		// Update the elapsed time with a rough estimate.
 		m_elapsed_time += ((len == 0) ? std::abs(e) : len) / m_current_feedrate * 60.f;
-		m_gcode += "\n";
 		return *this;
 	}
 
@@ -249,12 +253,14 @@ public:
 	{
 		if (e == 0.f && (f == 0.f || f == m_current_feedrate))
 			return *this;
-		m_gcode += "G1";
+		unsigned char flags = 0;
 		if (e != 0.f)
-			m_gcode += set_format_E(e);
-		if (f != 0.f && f != m_current_feedrate)
-			m_gcode += set_format_F(f);
-		m_gcode += "\n";
+			flags |= WipeTower::GCodeLine::HasE;
+		if (f != 0.f && f != m_current_feedrate) {
+			flags |= WipeTower::GCodeLine::HasF;
+			m_current_feedrate = f;
+		}
+		m_gcode.move(flags, 0.f, 0.f, 0.f, e, f);
 		return *this;
 	}
 
@@ -281,10 +287,12 @@ public:
 	// Elevate the extruder head above the current print_z position.
 	WipeTowerWriter& z_hop(float hop, float f = 0.f)
 	{ 
-		m_gcode += std::string("G1") + set_format_Z(m_current_z + hop);
-		if (f != 0 && f != m_current_feedrate)
-			m_gcode += set_format_F(f);
-		m_gcode += "\n";
+		unsigned char flags = WipeTower::GCodeLine::HasZ;
+		if (f != 0 && f != m_current_feedrate) {
+			flags |= WipeTower::GCodeLine::HasF;
+			m_current_feedrate = f;
+		}
+		m_gcode.move(flags, 0.f, 0.f, m_current_z + hop, 0.f, f);
 		return *this;
 	}
 
@@ -321,8 +329,8 @@ public:
 	WipeTowerWriter& set_extruder_temp(int temperature, bool wait = false)
 	{
         char buf[128];
-        sprintf(buf, "M%d S%d\n", wait ? 109 : 104, temperature);
-        m_gcode += buf;
+        int len = sprintf(buf, "M%d S%d\n", wait ? 109 : 104, temperature);
+        m_gcode.append_text(buf, len);
         return *this;
 	};
 
@@ -332,8 +340,8 @@ public:
         if (time==0)
             return *this;
 		char buf[128];
-		sprintf(buf, "G4 S%.3f\n", time);
-		m_gcode += buf;
+		int len = sprintf(buf, "G4 S%.3f\n", time);
+		m_gcode.append_text(buf, len);
 		return *this;
 	};
 
@@ -341,22 +349,22 @@ public:
 	WipeTowerWriter& speed_override(int speed)
 	{
 		char buf[128];
-		sprintf(buf, "M220 S%d\n", speed);
-		m_gcode += buf;
+		int len = sprintf(buf, "M220 S%d\n", speed);
+		m_gcode.append_text(buf, len);
 		return *this;
 	};
 
 	// Let the firmware back up the active speed override value.
 	WipeTowerWriter& speed_override_backup()
 	{
-		m_gcode += "M220 B\n";
+		m_gcode.append_text("M220 B\n");
 		return *this;
 	};
 
 	// Let the firmware restore the active speed override value.
 	WipeTowerWriter& speed_override_restore()
 	{
-		m_gcode += "M220 R\n";
+		m_gcode.append_text("M220 R\n");
 		return *this;
 	};
 
@@ -364,24 +372,23 @@ public:
 	WipeTowerWriter& set_extruder_trimpot(int current)
 	{
 		char buf[128];
-        if (m_gcode_flavor == gcfRepRap)
-            sprintf(buf, "M906 E%d\n", current);
-        else
+        int len = (m_gcode_flavor == gcfRepRap) ?
+            sprintf(buf, "M906 E%d\n", current) :
             sprintf(buf, "M907 E%d\n", current);
-		m_gcode += buf;
+		m_gcode.append_text(buf, len);
 		return *this;
 	};
 
 	WipeTowerWriter& flush_planner_queue()
 	{ 
-		m_gcode += "G4 S0\n"; 
+		m_gcode.append_text("G4 S0\n");
 		return *this;
 	}
 
 	// Reset internal extruder counter.
 	WipeTowerWriter& reset_extruder()
 	{ 
-		m_gcode += "G92 E0\n";
+		m_gcode.append_text("G92 E0\n");
 		return *this;
 	}
 
@@ -389,7 +396,7 @@ public:
 	{
 		char strvalue[64];
 		sprintf(strvalue, "%d", value);
-		m_gcode += std::string(";") + comment + strvalue + "\n";
+		m_gcode.append_text(std::string(";") + comment + strvalue + "\n");
 		return *this;
 	};
 
@@ -400,19 +407,29 @@ public:
 			return *this;
 				
 		if (speed == 0)
-			m_gcode += "M107\n";
+			m_gcode.append_text("M107\n");
 		else
 		{
-			m_gcode += "M106 S";
 			char buf[128];
-			sprintf(buf,"%u\n",(unsigned int)(255.0 * speed / 100.0));
-			m_gcode += buf;
+			int len = sprintf(buf,"M106 S%u\n",(unsigned int)(255.0 * speed / 100.0));
+			m_gcode.append_text(buf, len);
 		}
 		m_last_fan_speed = speed;
 		return *this;
 	}
 
-	WipeTowerWriter& append(const std::string& text) { m_gcode += text; return *this; }
+	WipeTowerWriter& append(const std::string& text) { m_gcode.append_text(text); return *this; }
+
+	// Placeholder of a custom G-code section.
+	WipeTowerWriter& append_placeholder(WipeTower::GCodeLine::Type type) { m_gcode.append_placeholder(type); return *this; }
+
+	// Travel to the current position, even if the G-code generator believes the print head is there already.
+	WipeTowerWriter& travel_to_current_pos()
+	{
+		Vec2f pos = this->pos_rotated();
+		m_gcode.move(WipeTower::GCodeLine::HasX | WipeTower::GCodeLine::HasY | WipeTower::GCodeLine::NeverSkip, pos.x(), pos.y(), 0.f, 0.f, 0.f);
+		return *this;
+	}
 
 private:
 	Vec2f         m_start_pos;
@@ -423,7 +440,7 @@ private:
 	float 		  m_layer_height;
 	float 	  	  m_extrusion_flow;
 	bool		  m_preview_suppressed;
-	std::string   m_gcode;
+	WipeTower::GCodeLines m_gcode;
 	std::vector<WipeTower::Extrusion> m_extrusions;
 	float         m_elapsed_time;
 	float   	  m_internal_angle = 0.f;
@@ -437,40 +454,6 @@ private:
     GCodeFlavor   m_gcode_flavor;
     const std::vector<WipeTower::FilamentParameters>& m_filpar;
 
-	std::string   set_format_X(float x)
-	{
-		char buf[64];
-		sprintf(buf, " X%.3f", x);
-		m_current_pos.x() = x;
-		return buf;
-	}
-
-	std::string   set_format_Y(float y) {
-		char buf[64];
-		sprintf(buf, " Y%.3f", y);
-		m_current_pos.y() = y;
-		return buf;
-	}
-
-	std::string   set_format_Z(float z) {
-		char buf[64];
-		sprintf(buf, " Z%.3f", z);
-		return buf;
-	}
-
-	std::string   set_format_E(float e) {
-		char buf[64];
-		sprintf(buf, " E%.4f", e);
-		return buf;
-	}
-
-	std::string   set_format_F(float f) {
-		char buf[64];
-		sprintf(buf, " F%d", int(floor(f + 0.5f)));
-		m_current_feedrate = f;
-		return buf;
-	}
-
 	WipeTowerWriter& operator=(const WipeTowerWriter &rhs);
 }; // class WipeTowerWriter
 
@@ -1004,17 +987,17 @@ void WipeTower::toolchange_Change(
 
     // This is where we want to place the custom gcodes. We will use placeholders for this.
     // These will be substituted by the actual gcodes when the gcode is generated.
-    writer.append("[end_filament_gcode]\n");
-    writer.append("[toolchange_gcode]\n");
+    writer.append_placeholder(GCodeLine::EndFilamentGCode);
+    writer.append_placeholder(GCodeLine::ToolchangeGCode);
 
     // Travel to where we assume we are. Custom toolchange or some special T code handling (parking extruder etc)
     // gcode could have left the extruder somewhere, we cannot just start extruding.
-    writer.append(std::string("G1 X") + std::to_string(writer.x()) +  " Y" + std::to_string(writer.y()) +  "\n");
+    writer.travel_to_current_pos();
 
     // The toolchange Tn command will be inserted later, only in case that the user does
     // not provide a custom toolchange gcode.
 	writer.set_tool(new_tool); // This outputs nothing, the writer just needs to know the tool has changed.
-    writer.append("[start_filament_gcode]\n");
+    writer.append_placeholder(GCodeLine::StartFilamentGCode);
 
 	writer.flush_planner_queue();
 	m_current_tool = new_tool;
@@ -1359,12 +1342,11 @@ void WipeTower::generate(std::vector<std::vector<WipeTower::ToolChangeResult>> &
             auto finish_layer_toolchange = finish_layer();
             if ( ! layer.tool_changes.empty() ) { // we will merge it to the last toolchange
                 auto& last_toolchange = layer_result.back();
-                if (last_toolchange.end_pos != finish_layer_toolchange.start_pos) {
-                    char buf[2048];     // Add a travel move from tc1.end_pos to tc2.start_pos.
-					sprintf(buf, "G1 X%.3f Y%.3f F7200\n", finish_layer_toolchange.start_pos.x(), finish_layer_toolchange.start_pos.y());
-					last_toolchange.gcode += buf;
-				}
-                last_toolchange.gcode += finish_layer_toolchange.gcode;
+                if (last_toolchange.end_pos != finish_layer_toolchange.start_pos)
+                    // Add a travel move from tc1.end_pos to tc2.start_pos.
+					last_toolchange.gcode.move(GCodeLine::HasX | GCodeLine::HasY | GCodeLine::HasF,
+						finish_layer_toolchange.start_pos.x(), finish_layer_toolchange.start_pos.y(), 0.f, 0.f, 7200.f);
+                last_toolchange.gcode.append(finish_layer_toolchange.gcode);
                 last_toolchange.extrusions.insert(last_toolchange.extrusions.end(), finish_layer_toolchange.extrusions.begin(), finish_layer_toolchange.extrusions.end());
                 last_toolchange.end_pos = finish_layer_toolchange.end_pos;
             }
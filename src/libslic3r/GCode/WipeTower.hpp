@@ -32,13 +32,90 @@ public:
 		unsigned int    tool;
 	};
 
+	// A line of the G-code of a tool change.
+	struct GCodeLine
+	{
+		enum Type : unsigned char {
+			// G1 with the axes flagged by HasX .. HasF.
+			Move,
+			// Verbatim G-code, a range of GCodeLines::text.
+			Text,
+			// Placeholders of the custom G-code sections, to be filled in by the G-code generator.
+			EndFilamentGCode,
+			ToolchangeGCode,
+			StartFilamentGCode,
+		};
+		enum Flags : unsigned char {
+			HasX 		= 1,
+			HasY 		= 2,
+			HasZ 		= 4,
+			HasE 		= 8,
+			HasF 		= 16,
+			// Emit both X and Y, even if the G-code generator believes the print head is there already.
+			NeverSkip 	= 32,
+		};
+
+		Type 			type;
+		unsigned char 	flags;
+		// Move: X and Y in the wipe tower coordinate system, Z, E and F.
+		float 			x, y, z, e, f;
+		// Text: range of GCodeLines::text.
+		uint32_t 		text_begin, text_end;
+	};
+
+	// G-code of a tool change. The moves are kept in the wipe tower coordinate system, they are transformed
+	// and formatted just once by the G-code generator, when the tool change is emitted.
+	struct GCodeLines
+	{
+		std::vector<GCodeLine> 	lines;
+		// Verbatim G-code of all the Text lines.
+		std::string 			text;
+
+		void move(unsigned char flags, float x, float y, float z, float e, float f) {
+			GCodeLine line;
+			line.type  = GCodeLine::Move;
+			line.flags = flags;
+			line.x = x; line.y = y; line.z = z; line.e = e; line.f = f;
+			line.text_begin = line.text_end = 0;
+			this->lines.emplace_back(line);
+		}
+		void append_text(const char *str, size_t len) {
+			if (this->lines.empty() || this->lines.back().type != GCodeLine::Text) {
+				GCodeLine line;
+				line.type  = GCodeLine::Text;
+				line.flags = 0;
+				line.x = line.y = line.z = line.e = line.f = 0.f;
+				line.text_begin = line.text_end = uint32_t(this->text.size());
+				this->lines.emplace_back(line);
+			}
+			this->text.append(str, len);
+			this->lines.back().text_end = uint32_t(this->text.size());
+		}
+		void append_text(const std::string &str) { this->append_text(str.data(), str.size()); }
+		void append_placeholder(GCodeLine::Type type) {
+			GCodeLine line;
+			line.type  = type;
+			line.flags = 0;
+			line.x = line.y = line.z = line.e = line.f = 0.f;
+			line.text_begin = line.text_end = 0;
+			this->lines.emplace_back(line);
+		}
+		void append(const GCodeLines &rhs) {
+			for (const GCodeLine &line : rhs.lines)
+				if (line.type == GCodeLine::Text)
+					this->append_text(rhs.text.data() + line.text_begin, line.text_end - line.text_begin);
+				else
+					this->lines.emplace_back(line);
+		}
+	};
+
 	struct ToolChangeResult
 	{
 		// Print heigh of this tool change.
 		float					print_z;
 		float 					layer_height;
-		// G-code section to be directly included into the output G-code.
-		std::string				gcode;
+		// G-code section to be included into the output G-code.
+		GCodeLines				gcode;
 		// For path preview.
 		std::vector<Extrusion> 	extrusions;
 		// Initial position, at which the wipe tower starts its action.
@@ -7,6 +7,8 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 namespace Slic3r {
 
 Layer::~Layer()
@@ -33,6 +35,14 @@ LayerRegion* Layer::add_region(PrintRegion* print_region)
     return m_regions.back();
 }
 
+void Layer::trim_regions(size_t num_regions)
+{
+    for (size_t i = num_regions; i < m_regions.size(); ++ i)
+        delete m_regions[i];
+    if (num_regions < m_regions.size())
+        m_regions.erase(m_regions.begin() + num_regions, m_regions.end());
+}
+
 // merge all regions' slices to get islands
 void Layer::make_slices()
 {
@@ -63,6 +73,33 @@ void Layer::make_slices()
     // populate slices vector
     for (size_t i : order)
         this->slices.expolygons.push_back(std::move(slices[i]));
+
+    this->invalidate_slices_cache();
+}
+
+Polygons Layer::slices_offset(float delta, ClipperLib::JoinType joinType, double miterLimit) const
+{
+    auto key  = std::make_tuple(delta, int(joinType), miterLimit);
+    auto find = [this, &key]() {
+        return std::find_if(m_slices_offset_cache.begin(), m_slices_offset_cache.end(),
+            [&key](const std::pair<std::tuple<float, int, double>, Polygons> &kvp) { return kvp.first == key; });
+    };
+    {
+        std::lock_guard<std::mutex> lock(m_slices_offset_cache_mutex);
+        auto it = find();
+        if (it != m_slices_offset_cache.end())
+            return it->second;
+    }
+    // The offset is calculated without holding the lock, so that the requests for the other offsets are not blocked.
+    // Two threads may calculate the same offset concurrently, then the first result is kept.
+    Polygons out = offset(this->slices.expolygons, delta, joinType, miterLimit);
+    std::lock_guard<std::mutex> lock(m_slices_offset_cache_mutex);
+    if (find() == m_slices_offset_cache.end()) {
+        if (m_slices_offset_cache.size() >= max_slices_offsets_cached)
+            m_slices_offset_cache.erase(m_slices_offset_cache.begin());
+        m_slices_offset_cache.emplace_back(key, out);
+    }
+    return out;
 }
 
 // Merge typed slices into untyped slices. This method is used to revert the effects of detect_surfaces_type() called for posPrepareInfill.
@@ -106,17 +143,19 @@ void Layer::make_perimeters()
     
     // keep track of regions whose perimeters we have already generated
     std::vector<unsigned char> done(m_regions.size(), false);
+    // Groups of regions with compatible perimeter settings (region_id of the first region, regions of the group).
+    std::vector<std::pair<size_t, LayerRegionPtrs>> groups;
     
     for (LayerRegionPtrs::iterator layerm = m_regions.begin(); layerm != m_regions.end(); ++ layerm) {
         size_t region_id = layerm - m_regions.begin();
         if (done[region_id])
             continue;
-        BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << ", region " << region_id;
         done[region_id] = true;
         const PrintRegionConfig &config = (*layerm)->region()->config();
         
         // find compatible regions
-        LayerRegionPtrs layerms;
+        groups.emplace_back(region_id, LayerRegionPtrs());
+        LayerRegionPtrs &layerms = groups.back().second;
         layerms.push_back(*layerm);
         for (LayerRegionPtrs::const_iterator it = layerm + 1; it != m_regions.end(); ++it) {
             LayerRegion* other_layerm = *it;
@@ -135,39 +174,59 @@ void Layer::make_perimeters()
                 done[it - m_regions.begin()] = true;
             }
         }
-        
-        if (layerms.size() == 1) {  // optimization
-            (*layerm)->fill_surfaces.surfaces.clear();
-            (*layerm)->make_perimeters((*layerm)->slices, &(*layerm)->fill_surfaces);
-            (*layerm)->fill_expolygons = to_expolygons((*layerm)->fill_surfaces.surfaces);
-        } else {
-            SurfaceCollection new_slices;
-            {
-                // group slices (surfaces) according to number of extra perimeters
-                std::map<unsigned short, Surfaces> slices;  // extra_perimeters => [ surface, surface... ]
-                for (LayerRegion *layerm : layerms)
-                    for (Surface &surface : layerm->slices.surfaces)
-                        slices[surface.extra_perimeters].emplace_back(surface);
-                // merge the surfaces assigned to each group
-                for (std::pair<const unsigned short,Surfaces> &surfaces_with_extra_perimeters : slices)
-                    new_slices.append(union_ex(surfaces_with_extra_perimeters.second, true), surfaces_with_extra_perimeters.second.front());
-            }
-            
-            // make perimeters
-            SurfaceCollection fill_surfaces;
-            (*layerm)->make_perimeters(new_slices, &fill_surfaces);
-
-            // assign fill_surfaces to each layer
-            if (!fill_surfaces.surfaces.empty()) { 
-                for (LayerRegionPtrs::iterator l = layerms.begin(); l != layerms.end(); ++l) {
-                    // Separate the fill surfaces.
-                    ExPolygons expp = intersection_ex(to_polygons(fill_surfaces), (*l)->slices);
-                    (*l)->fill_expolygons = expp;
-                    (*l)->fill_surfaces.set(std::move(expp), fill_surfaces.surfaces.front());
+    }
+
+    // The groups are disjoint and each group only writes into its own regions, therefore the groups are processed in parallel.
+    // This nests into the parallel loop over layers in PrintObject::_make_perimeters(), it pays off for objects with many modifiers.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, groups.size()),
+        [this, &groups](const tbb::blocked_range<size_t>& range) {
+            for (size_t group_id = range.begin(); group_id < range.end(); ++ group_id) {
+                const LayerRegionPtrs &layerms = groups[group_id].second;
+                LayerRegion           *layerm  = layerms.front();
+                BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << ", region " << groups[group_id].first;
+                if (layerms.size() == 1) {  // optimization
+                    layerm->fill_surfaces.surfaces.clear();
+                    layerm->make_perimeters(layerm->slices, &layerm->fill_surfaces);
+                    layerm->fill_expolygons = to_expolygons(layerm->fill_surfaces.surfaces);
+                } else {
+                    SurfaceCollection new_slices;
+                    {
+                        // group slices (surfaces) according to number of extra perimeters
+                        std::map<unsigned short, Surfaces> slices;  // extra_perimeters => [ surface, surface... ]
+                        for (LayerRegion *layerm : layerms)
+                            for (Surface &surface : layerm->slices.surfaces)
+                                slices[surface.extra_perimeters].emplace_back(surface);
+                        // merge the surfaces assigned to each group
+                        for (std::pair<const unsigned short,Surfaces> &surfaces_with_extra_perimeters : slices)
+                            new_slices.append(union_ex(surfaces_with_extra_perimeters.second, true), surfaces_with_extra_perimeters.second.front());
+                    }
+                    
+                    // make perimeters
+                    SurfaceCollection fill_surfaces;
+                    layerm->make_perimeters(new_slices, &fill_surfaces);
+
+                    // assign fill_surfaces to each layer
+                    for (LayerRegion *l : layerms) {
+                        // The layers are kept between the slicing runs, clear what the previous run left in the regions.
+                        if (l != layerm) {
+                            l->perimeters.clear();
+                            l->thin_fills.clear();
+                        }
+                        if (fill_surfaces.surfaces.empty()) {
+                            l->fill_expolygons.clear();
+                            l->fill_surfaces.surfaces.clear();
+                        } else {
+                            // Separate the fill surfaces.
+                            ExPolygons expp = intersection_ex(to_polygons(fill_surfaces), l->slices);
+                            l->fill_expolygons = expp;
+                            l->fill_surfaces.set(std::move(expp), fill_surfaces.surfaces.front());
+                        }
+                    }
                 }
             }
         }
-    }
+    );
     BOOST_LOG_TRIVIAL(trace) << "Generating perimeters for layer " << this->id() << " - Done";
 }
 
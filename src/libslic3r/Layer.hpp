@@ -7,6 +7,12 @@
 #include "ExtrusionEntityCollection.hpp"
 #include "ExPolygonCollection.hpp"
 #include "PolylineCollection.hpp"
+#include "clipper.hpp"
+
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 
 namespace Slic3r {
@@ -118,6 +124,8 @@ public:
     const LayerRegion*      get_region(int idx) const { return m_regions.at(idx); }
     LayerRegion*            get_region(int idx) { return m_regions[idx]; }
     LayerRegion*            add_region(PrintRegion* print_region);
+    // Delete the layer regions past num_regions.
+    void                    trim_regions(size_t num_regions);
     const LayerRegionPtrs&  regions() const { return m_regions; }
     // Test whether whether there are any slices assigned to this layer.
     bool                    empty() const;    
@@ -126,6 +134,14 @@ public:
     void                    merge_slices();
     // Slices merged into islands, to be used by the elephant foot compensation to trim the individual surfaces with the shrunk merged slices.
     ExPolygons              merged(float offset) const;
+    // Offset of this->slices, memoized, so that the support layers overlapping this layer share the result.
+    // The offsets are kept until this->slices change, so that a step executed again (for example after a change
+    // of the support settings) reuses them. At most max_slices_offsets_cached offsets are kept, the oldest one is dropped first.
+    // Thread safe. Returns a copy, as the memoized offset may be dropped by another thread.
+    Polygons                slices_offset(float delta, ClipperLib::JoinType joinType = ClipperLib::jtMiter, double miterLimit = 3) const;
+    // To be called whenever this->slices are modified.
+    // Not thread safe with slices_offset().
+    void                    invalidate_slices_cache() { m_slices_offset_cache.clear(); }
     template <class T> bool any_internal_region_slice_contains(const T &item) const {
         for (const LayerRegion *layerm : m_regions) if (layerm->slices.any_internal_contains(item)) return true;
         return false;
@@ -160,6 +176,11 @@ private:
     size_t              m_id;
     PrintObject        *m_object;
     LayerRegionPtrs     m_regions;
+
+    // Memoized offsets of this->slices, see slices_offset(). Keyed by delta, join type and miter limit, the oldest first.
+    static const size_t                                                     max_slices_offsets_cached = 2;
+    mutable std::vector<std::pair<std::tuple<float, int, double>, Polygons>> m_slices_offset_cache;
+    mutable std::mutex                                                      m_slices_offset_cache_mutex;
 };
 
 class SupportLayer : public Layer 
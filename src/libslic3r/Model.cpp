@@ -816,10 +816,15 @@ TriangleMesh ModelObject::mesh() const
 {
     TriangleMesh mesh;
     TriangleMesh raw_mesh = this->raw_mesh();
-    for (const ModelInstance *i : this->instances) {
-        TriangleMesh m = raw_mesh;
-        i->transform_mesh(&m);
-        mesh.merge(m);
+    if (! this->instances.empty()) {
+        if (this->instances.size() > 1)
+            mesh.reserve(raw_mesh.facets_count() * this->instances.size());
+        // Merge the transformed copies of the raw mesh without materializing them,
+        // the last instance transforms the raw mesh in place and hands it over.
+        for (size_t i = 0; i + 1 < this->instances.size(); ++ i)
+            mesh.merge(raw_mesh, this->instances[i]->get_matrix());
+        this->instances.back()->transform_mesh(&raw_mesh);
+        mesh.merge(std::move(raw_mesh));
     }
     return mesh;
 }
@@ -830,13 +835,15 @@ TriangleMesh ModelObject::mesh() const
 TriangleMesh ModelObject::raw_mesh() const
 {
     TriangleMesh mesh;
+    size_t       num_facets = 0;
     for (const ModelVolume *v : this->volumes)
         if (v->is_model_part())
-        {
-            TriangleMesh vol_mesh(v->mesh());
-            vol_mesh.transform(v->get_matrix());
-            mesh.merge(vol_mesh);
-        }
+            num_facets += v->mesh().facets_count();
+    mesh.reserve(num_facets);
+    for (const ModelVolume *v : this->volumes)
+        if (v->is_model_part())
+            // The volume meshes are shared, merge their transformed facets without copying the volume meshes first.
+            mesh.merge(v->mesh(), v->get_matrix());
     return mesh;
 }
 
@@ -844,12 +851,12 @@ TriangleMesh ModelObject::raw_mesh() const
 TriangleMesh ModelObject::full_raw_mesh() const
 {
     TriangleMesh mesh;
+    size_t       num_facets = 0;
     for (const ModelVolume *v : this->volumes)
-    {
-        TriangleMesh vol_mesh(v->mesh());
-        vol_mesh.transform(v->get_matrix());
-        mesh.merge(vol_mesh);
-    }
+        num_facets += v->mesh().facets_count();
+    mesh.reserve(num_facets);
+    for (const ModelVolume *v : this->volumes)
+        mesh.merge(v->mesh(), v->get_matrix());
     return mesh;
 }
 
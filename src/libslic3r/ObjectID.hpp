@@ -3,6 +3,9 @@
 
 #include <cereal/access.hpp>
 
+#include <cstddef>
+#include <functional>
+
 namespace Slic3r {
 
 namespace UndoRedo {
@@ -40,6 +43,12 @@ private:
 	template<class Archive> void serialize(Archive &ar) { ar(id); }
 };
 
+// Hash of ObjectID to be used by std::unordered_map / std::unordered_set.
+struct ObjectIDHash
+{
+	size_t operator()(const ObjectID &id) const { return std::hash<size_t>()(id.id); }
+};
+
 // Base for Model, ModelObject, ModelVolume, ModelInstance or ModelMaterial to provide a unique ID
 // to synchronize the front end (UI) with the back end (BackgroundSlicingProcess / Print / PrintObject).
 // Achtung! The s_last_id counter is not thread safe, so it is expected, that the ObjectBase derived instances
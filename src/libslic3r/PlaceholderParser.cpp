@@ -62,7 +62,8 @@
 
 namespace Slic3r {
 
-PlaceholderParser::PlaceholderParser(const DynamicConfig *external_config) : m_external_config(external_config)
+PlaceholderParser::PlaceholderParser(const DynamicConfig *external_config) : 
+    m_external_config(external_config), m_serialization_cache(std::make_shared<ConfigSerializationCache>())
 {
     this->set("version", std::string(SLIC3R_VERSION));
     this->apply_env_variables();
@@ -611,6 +612,8 @@ namespace client
         const DynamicConfig     *config                 = nullptr;
         const DynamicConfig     *config_override        = nullptr;
         size_t                   current_extruder_id    = 0;
+        // Cache of the serialized variables, may be null.
+        ConfigSerializationCache *serialization_cache   = nullptr;
         // If false, the macro_processor will evaluate a full macro.
         // If true, the macro processor will evaluate just a boolean condition using the full expressive power of the macro processor.
         bool                     just_boolean_expression = false;
@@ -621,6 +624,11 @@ namespace client
 
         static void             evaluate_full_macro(const MyContext *ctx, bool &result) { result = ! ctx->just_boolean_expression; }
 
+        std::string             serialize(const std::string &opt_key, const ConfigOption &opt) const
+            { return (serialization_cache == nullptr) ? opt.serialize() : serialization_cache->serialize(opt_key, opt); }
+        std::string             serialize_at(const std::string &opt_key, const ConfigOptionVectorBase &opt, size_t idx) const
+            { return (serialization_cache == nullptr) ? opt.vserialize()[idx] : serialization_cache->serialize_at(opt_key, opt, idx); }
+
         const ConfigOption*     resolve_symbol(const std::string &opt_key) const
         {
             const ConfigOption *opt = nullptr;
@@ -660,12 +668,12 @@ namespace client
             if (opt == nullptr)
                 ctx->throw_exception("Variable does not exist", boost::iterator_range<Iterator>(opt_key.begin(), opt_key.end()));
             if (opt->is_scalar())
-                output = opt->serialize();
+                output = ctx->serialize(opt_key_str, *opt);
             else {
                 const ConfigOptionVectorBase *vec = static_cast<const ConfigOptionVectorBase*>(opt);
                 if (vec->empty())
                     ctx->throw_exception("Indexing an empty vector variable", opt_key);
-                output = vec->vserialize()[(idx >= vec->size()) ? 0 : idx];
+                output = ctx->serialize_at(opt_key_str, *vec, (idx >= vec->size()) ? 0 : idx);
             }
         }
 
@@ -697,7 +705,7 @@ namespace client
 			int idx = opt_index->getInt();
 			if (idx < 0)
                 ctx->throw_exception("Negative vector index", opt_key);
-			output = vec->vserialize()[(idx >= (int)vec->size()) ? 0 : idx];
+			output = ctx->serialize_at(opt_key_str, *vec, (idx >= (int)vec->size()) ? 0 : idx);
         }
 
         template <typename Iterator>
@@ -1261,6 +1269,7 @@ std::string PlaceholderParser::process(const std::string &templ, unsigned int cu
     context.config              = &this->config();
     context.config_override     = config_override;
     context.current_extruder_id = current_extruder_id;
+    context.serialization_cache = m_serialization_cache.get();
     return process_macro(templ, context);
 }
 
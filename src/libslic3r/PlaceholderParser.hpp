@@ -56,6 +56,8 @@ private:
 	// config has a higher priority than external_config when looking up a symbol.
     DynamicConfig 			 m_config;
     const DynamicConfig 	*m_external_config;
+    // Serialized values of the variables expanded by the templates. Shared by the copies of this PlaceholderParser.
+    std::shared_ptr<ConfigSerializationCache> m_serialization_cache;
 };
 
 }
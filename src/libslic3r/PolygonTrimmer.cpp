@@ -2,6 +2,8 @@
 #include "EdgeGrid.hpp"
 #include "Geometry.hpp"
 
+#include <algorithm>
+
 namespace Slic3r {
 
 TrimmedLoop trim_loop(const Polygon &loop, const EdgeGrid::Grid &grid)
@@ -53,4 +55,215 @@ std::vector<TrimmedLoop> trim_loops(const Polygons &loops, const EdgeGrid::Grid
 	return out;
 }
 
+// Intersection of a polyline segment with a boundary edge, parametrized by the segment length.
+struct SegmentIntersection
+{
+	SegmentIntersection(double t, bool proper) : t(t), proper(proper) {}
+	double 	t;
+	// The segment crosses the interior of the edge, thus the inside / outside state flips.
+	bool 	proper;
+	bool operator<(const SegmentIntersection &rhs) const { return this->t < rhs.t; }
+};
+
+static inline void intersect_segment_edge(const Point &a, const Point &b, const Point &c, const Point &d, std::vector<SegmentIntersection> &out)
+{
+	Vec2i64 ab = b.cast<int64_t>() - a.cast<int64_t>();
+	int64_t d1 = cross2(ab, Vec2i64(c.cast<int64_t>() - a.cast<int64_t>()));
+	int64_t d2 = cross2(ab, Vec2i64(d.cast<int64_t>() - a.cast<int64_t>()));
+	if ((d1 > 0 && d2 > 0) || (d1 < 0 && d2 < 0))
+		return;
+	Vec2i64 cd = d.cast<int64_t>() - c.cast<int64_t>();
+	int64_t d3 = cross2(cd, Vec2i64(a.cast<int64_t>() - c.cast<int64_t>()));
+	int64_t d4 = cross2(cd, Vec2i64(b.cast<int64_t>() - c.cast<int64_t>()));
+	if ((d3 > 0 && d4 > 0) || (d3 < 0 && d4 < 0))
+		return;
+	if (d1 == 0 && d2 == 0) {
+		// Collinear, the segment overlaps with the edge. Split the segment at both ends of the overlap.
+		Vec2d  vab = ab.cast<double>();
+		double l2  = vab.squaredNorm();
+		double tc  = (c - a).cast<double>().dot(vab) / l2;
+		double td  = (d - a).cast<double>().dot(vab) / l2;
+		double t1  = std::max(0., std::min(tc, td));
+		double t2  = std::min(1., std::max(tc, td));
+		if (t1 <= t2) {
+			out.emplace_back(t1, false);
+			out.emplace_back(t2, false);
+		}
+	} else if (d3 != d4)
+		out.emplace_back(std::min(1., std::max(0., double(d3) / (double(d3) - double(d4)))), d1 != 0 && d2 != 0 && d3 != 0 && d4 != 0);
+}
+
+// Point in ExPolygon test by the parity of the crossings of a horizontal ray with the boundary.
+// The boundary edges are sorted into rows, so that only the edges of a single row are tested.
+class ExPolygonRows
+{
+public:
+	ExPolygonRows(const ExPolygon &expolygon, const BoundingBox &bbox, coord_t resolution) : 
+		m_bbox(bbox), m_resolution(resolution), m_rows(size_t((bbox.max(1) - bbox.min(1)) / resolution) + 1)
+	{
+		this->add(expolygon.contour.points);
+		for (const Polygon &hole : expolygon.holes)
+			this->add(hole.points);
+	}
+
+	bool contains(const Vec2d &pt) const
+	{
+		if (pt(0) < m_bbox.min(0) || pt(0) > m_bbox.max(0) || pt(1) < m_bbox.min(1) || pt(1) > m_bbox.max(1))
+			return false;
+		bool inside = false;
+		for (const Line &edge : m_rows[this->row(pt(1))])
+			if ((edge.a(1) > pt(1)) != (edge.b(1) > pt(1)) &&
+				edge.a(0) + (pt(1) - edge.a(1)) * double(edge.b(0) - edge.a(0)) / double(edge.b(1) - edge.a(1)) > pt(0))
+				inside = ! inside;
+		return inside;
+	}
+
+private:
+	size_t row(double y) const { return std::min(m_rows.size() - 1, size_t(std::max(0., (y - m_bbox.min(1)) / m_resolution))); }
+
+	void add(const Points &pts)
+	{
+		for (size_t i = 0; i < pts.size(); ++ i) {
+			const Point &p1 = pts[i];
+			const Point &p2 = pts[(i + 1 == pts.size()) ? 0 : i + 1];
+			// Horizontal edges are never crossed by the horizontal ray.
+			if (p1(1) != p2(1))
+				for (size_t r = this->row(std::min(p1(1), p2(1))); r <= this->row(std::max(p1(1), p2(1))); ++ r)
+					m_rows[r].emplace_back(p1, p2);
+		}
+	}
+
+	BoundingBox 					m_bbox;
+	coord_t 						m_resolution;
+	std::vector<std::vector<Line>> 	m_rows;
+};
+
+Polylines trim_polylines(const Polylines &polylines, const ExPolygon &expolygon)
+{
+	Polylines out;
+	if (expolygon.contour.points.size() < 3)
+		return out;
+
+	// Size the grid cells to hold about a single boundary edge each.
+	size_t num_edges = expolygon.contour.points.size();
+	for (const Polygon &hole : expolygon.holes)
+		num_edges += hole.points.size();
+	BoundingBox bbox = get_extents(expolygon.contour);
+	coord_t resolution = std::max(coord_t(scale_(0.01)), coord_t(sqrt(double(bbox.size()(0)) * double(bbox.size()(1)) / double(num_edges))));
+
+	EdgeGrid::Grid grid;
+	grid.create(expolygon, resolution);
+	const BoundingBox &grid_bbox = grid.bbox();
+	ExPolygonRows rows(expolygon, grid_bbox, resolution);
+
+	// Collect the boundary edges from the grid cells the segment passes through. The query is padded,
+	// so that an intersection falling onto a cell boundary is not missed due to the rounding.
+	std::vector<std::pair<size_t, size_t>> edges;
+	auto collect_edges = [&grid, &grid_bbox, resolution, &edges](const Point &a, const Point &b) {
+		const double pad  = 2.;
+		double ymin = std::max(double(std::min(a(1), b(1))) - pad, double(grid_bbox.min(1)));
+		double ymax = std::min(double(std::max(a(1), b(1))) + pad, double(grid_bbox.max(1)));
+		double xmin = double(std::min(a(0), b(0)));
+		double xmax = double(std::max(a(0), b(0)));
+		for (coord_t r = coord_t((ymin - grid_bbox.min(1)) / resolution); r < coord_t(grid.rows()) && grid_bbox.min(1) + double(r) * resolution <= ymax; ++ r) {
+			// Span of the segment over the row.
+			double x0 = xmin;
+			double x1 = xmax;
+			if (a(1) != b(1)) {
+				double y0 = std::max(ymin, grid_bbox.min(1) + double(r) * resolution);
+				double y1 = std::min(ymax, grid_bbox.min(1) + double(r + 1) * resolution);
+				double dxdy = double(b(0) - a(0)) / double(b(1) - a(1));
+				double xa = a(0) + (y0 - a(1)) * dxdy;
+				double xb = a(0) + (y1 - a(1)) * dxdy;
+				x0 = std::max(x0, std::min(xa, xb));
+				x1 = std::min(x1, std::max(xa, xb));
+			}
+			x0 = std::max(x0 - pad, double(grid_bbox.min(0)));
+			x1 = std::min(x1 + pad, double(grid_bbox.max(0)));
+			if (x0 > x1)
+				continue;
+			coord_t c1 = coord_t((x0 - grid_bbox.min(0)) / resolution);
+			coord_t c2 = std::min(coord_t(grid.cols()) - 1, coord_t((x1 - grid_bbox.min(0)) / resolution));
+			for (coord_t c = c1; c <= c2; ++ c) {
+				auto cell_data_range = grid.cell_data_range(r, c);
+				edges.insert(edges.end(), cell_data_range.first, cell_data_range.second);
+			}
+		}
+		sort_remove_duplicates(edges);
+	};
+
+	std::vector<SegmentIntersection> intersections;
+	for (const Polyline &polyline : polylines) {
+		Polyline current;
+		auto append = [&current](const Point &pt) {
+			if (current.points.empty() || current.points.back() != pt)
+				current.points.emplace_back(pt);
+		};
+		auto flush = [&out, &current]() {
+			if (current.points.size() >= 2)
+				out.emplace_back(std::move(current));
+			current.points.clear();
+		};
+		// Is the current point inside the ExPolygon? Unknown at the start of the polyline
+		// and after touching the boundary, then it is resolved by a point in polygon test.
+		bool inside = false;
+		bool known  = false;
+		for (size_t i = 1; i < polyline.points.size(); ++ i) {
+			const Point &a = polyline.points[i - 1];
+			const Point &b = polyline.points[i];
+			if (a == b)
+				continue;
+			intersections.clear();
+			if (std::max(a(0), b(0)) >= grid_bbox.min(0) && std::min(a(0), b(0)) <= grid_bbox.max(0) &&
+				std::max(a(1), b(1)) >= grid_bbox.min(1) && std::min(a(1), b(1)) <= grid_bbox.max(1)) {
+				edges.clear();
+				collect_edges(a, b);
+				for (const std::pair<size_t, size_t> &edge : edges) {
+					auto segment = grid.segment(edge);
+					intersect_segment_edge(a, b, segment.first, segment.second, intersections);
+				}
+				std::sort(intersections.begin(), intersections.end());
+			}
+			auto point_at = [&a, &b](double t) {
+				return (t <= 0.) ? a : (t >= 1.) ? b : 
+					Point(coord_t(floor(a(0) + t * double(b(0) - a(0)) + 0.5)), coord_t(floor(a(1) + t * double(b(1) - a(1)) + 0.5)));
+			};
+			size_t k = 0;
+			for (; k < intersections.size() && intersections[k].t <= 0.; ++ k)
+				known = false;
+			double t_prev = 0.;
+			for (;;) {
+				double t_next = (k < intersections.size()) ? intersections[k].t : 1.;
+				if (t_next > t_prev) {
+					if (! known) {
+						double t = 0.5 * (t_prev + t_next);
+						inside = rows.contains(Vec2d(a(0) + t * double(b(0) - a(0)), a(1) + t * double(b(1) - a(1))));
+						known  = true;
+					}
+					if (inside) {
+						append(point_at(t_prev));
+						append(point_at(t_next));
+					} else
+						flush();
+				}
+				if (k == intersections.size())
+					break;
+				// A single proper crossing flips the state, otherwise the boundary was touched.
+				size_t cnt    = 0;
+				bool   proper = true;
+				for (; k < intersections.size() && intersections[k].t == t_next; ++ k, ++ cnt)
+					proper &= intersections[k].proper;
+				if (cnt == 1 && proper && known)
+					inside = ! inside;
+				else
+					known = false;
+				t_prev = t_next;
+			}
+		}
+		flush();
+	}
+
+	return out;
+}
+
 }
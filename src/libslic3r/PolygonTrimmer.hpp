@@ -8,6 +8,7 @@
 #include "MultiPoint.hpp"
 #include "Polyline.hpp"
 #include "Polygon.hpp"
+#include "ExPolygon.hpp"
 
 namespace Slic3r {
 
@@ -27,6 +28,13 @@ struct TrimmedLoop
 TrimmedLoop trim_loop(const Polygon &loop, const EdgeGrid::Grid &grid);
 std::vector<TrimmedLoop> trim_loops(const Polygons &loops, const EdgeGrid::Grid &grid);
 
+// Clip open polylines by an ExPolygon, return the parts of the polylines inside the ExPolygon.
+// A replacement of intersection_pl() for the infill patterns made of many short segments:
+// the boundary edges are indexed by an EdgeGrid, so that a segment away from the boundary costs
+// a single grid cell lookup, and the inside / outside state flips at the boundary crossings.
+// The clipped pieces are returned in the order of the input polylines and their segments.
+Polylines trim_polylines(const Polylines &polylines, const ExPolygon &expolygon);
+
 } // namespace Slic3r
 
 #endif /* slic3r_PolygonTrimmer_hpp_ */
@@ -21,6 +21,8 @@
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
 
+#include <tbb/parallel_for.h>
+
 //! macro used to mark string used at localization,
 //! return same string
 #define L(s) Slic3r::I18N::translate(s)
@@ -42,6 +44,7 @@ void Print::clear()
         delete region;
     m_regions.clear();
     m_model.clear_objects();
+    this->slicing_topology_release_unused();
 }
 
 PrintRegion* Print::add_region()
@@ -116,6 +119,7 @@ bool Print::invalidate_state_by_config_options(const std::vector<t_config_option
         "output_filename_format",
         "perimeter_acceleration",
         "post_process",
+        "post_process_streaming",
         "printer_notes",
         "retract_before_travel",
         "retract_before_wipe",
@@ -330,6 +334,7 @@ void Print::_simplify_slices(double distance)
     for (PrintObject *object : m_objects) {
         for (Layer *layer : object->m_layers) {
             layer->slices.simplify(distance);
+            layer->invalidate_slices_cache();
             for (LayerRegion *layerm : layer->regions())
                 layerm->slices.simplify(distance);
         }
@@ -347,7 +352,7 @@ double Print::max_allowed_layer_height() const
 // Add or remove support modifier ModelVolumes from model_object_dst to match the ModelVolumes of model_object_new
 // in the exact order and with the same IDs.
 // It is expected, that the model_object_dst already contains the non-support volumes of model_object_new in the correct order.
-void Print::model_volume_list_update_supports(ModelObject &model_object_dst, const ModelObject &model_object_new)
+void Print::model_volume_list_update_modifiers(ModelObject &model_object_dst, const ModelObject &model_object_new)
 {
 	typedef std::pair<const ModelVolume*, bool> ModelVolumeWithStatus;
 	std::vector<ModelVolumeWithStatus> old_volumes;
@@ -367,18 +372,18 @@ void Print::model_volume_list_update_supports(ModelObject &model_object_dst, con
             assert(! it->second); // not consumed yet
             it->second = true;
             ModelVolume *model_volume_dst = const_cast<ModelVolume*>(it->first);
-			// For support modifiers, the type may have been switched from blocker to enforcer and vice versa.
-			assert((model_volume_dst->is_support_modifier() && model_volume_src->is_support_modifier()) || model_volume_dst->type() == model_volume_src->type());
+			// For modifiers, the type may have been switched from blocker to enforcer to a parameter modifier and vice versa.
+			assert((! model_volume_dst->is_model_part() && ! model_volume_src->is_model_part()) || model_volume_dst->type() == model_volume_src->type());
             model_object_dst.volumes.emplace_back(model_volume_dst);
-			if (model_volume_dst->is_support_modifier()) {
-				// For support modifiers, the type may have been switched from blocker to enforcer and vice versa.
+			if (! model_volume_dst->is_model_part()) {
+				// For modifiers, the type may have been switched from blocker to enforcer to a parameter modifier and vice versa.
 				model_volume_dst->set_type(model_volume_src->type());
 				model_volume_dst->set_transformation(model_volume_src->get_transformation());
 			}
             assert(model_volume_dst->get_matrix().isApprox(model_volume_src->get_matrix()));
         } else {
             // The volume was not found in the old list. Create a new copy.
-            assert(model_volume_src->is_support_modifier());
+            assert(! model_volume_src->is_model_part());
             model_object_dst.volumes.emplace_back(new ModelVolume(*model_volume_src));
             model_object_dst.volumes.back()->set_model_object(&model_object_dst);
         }
@@ -667,10 +672,21 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
 		ObjectID     id;
         Status       status;
         LayerRanges  layer_ranges;
+        // Regions of the volumes kept by the PrintObjects after a change of the modifiers, to be verified against the new regions.
+        struct VolumeRegion {
+            ObjectID             volume_id;
+            t_layer_height_range layer_range;
+            int                  region_id;
+            PrintRegionConfig    config;
+        };
+        std::vector<VolumeRegion> volume_regions;
         // Search by id.
-        bool operator<(const ModelObjectStatus &rhs) const { return id < rhs.id; }
+        bool operator==(const ModelObjectStatus &rhs) const { return id == rhs.id; }
     };
-    std::set<ModelObjectStatus> model_object_status;
+    struct ModelObjectStatusHash {
+        size_t operator()(const ModelObjectStatus &status) const { return ObjectIDHash()(status.id); }
+    };
+    std::unordered_set<ModelObjectStatus, ModelObjectStatusHash> model_object_status;
 
     // 1) Synchronize model objects.
     if (model.id() != m_model.id()) {
@@ -805,10 +821,12 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
         bool modifiers_differ           = model_volume_list_changed(model_object, model_object_new, ModelVolumeType::PARAMETER_MODIFIER);
         bool support_blockers_differ    = model_volume_list_changed(model_object, model_object_new, ModelVolumeType::SUPPORT_BLOCKER);
         bool support_enforcers_differ   = model_volume_list_changed(model_object, model_object_new, ModelVolumeType::SUPPORT_ENFORCER);
-        if (model_parts_differ || modifiers_differ || 
-            model_object.origin_translation         != model_object_new.origin_translation   ||
-            model_object.layer_height_profile       != model_object_new.layer_height_profile ||
-            ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, model_object_new.layer_height_profile.empty())) {
+        // Layer height ranges added, removed or their Z spans changed, which changes the assignment of the regions to the layers.
+        bool layer_ranges_differ        = ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, false);
+        bool layer_heights_differ       = model_object.layer_height_profile != model_object_new.layer_height_profile ||
+            ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, model_object_new.layer_height_profile.empty());
+        if (model_parts_differ || layer_ranges_differ ||
+            model_object.origin_translation         != model_object_new.origin_translation) {
             // The very first step (the slicing step) is invalidated. One may freely remove all associated PrintObjects.
             auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
             for (auto it = range.first; it != range.second; ++ it) {
@@ -817,18 +835,62 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             }
             // Copy content of the ModelObject including its ID, do not change the parent.
             model_object.assign_copy(model_object_new);
-        } else if (support_blockers_differ || support_enforcers_differ) {
-            // First stop background processing before shuffling or deleting the ModelVolumes in the ModelObject's list.
-            this->call_cancel_callback();
-            update_apply_status(false);
-            // Invalidate just the supports step.
-            auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
-            for (auto it = range.first; it != range.second; ++ it)
-                update_apply_status(it->print_object->invalidate_step(posSupportMaterial));
-            // Copy just the support volumes.
-            model_volume_list_update_supports(model_object, model_object_new);
+        } else {
+            if (layer_heights_differ) {
+                // Only the layer heights changed, for example by the variable layer height tool. The slicing step is invalidated,
+                // but the PrintObjects are kept with their regions and layers, so that the layers below the first modified layer
+                // are reused with their perimeters and infill.
+                // First stop background processing, so that the layers are not being modified while examined.
+                this->call_cancel_callback();
+                auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
+                for (auto it = range.first; it != range.second; ++ it)
+                    update_apply_status(it->print_object->invalidate_layer_heights());
+                // The layer heights of the layer height ranges are copied together with their configs below.
+                model_object.layer_height_profile = model_object_new.layer_height_profile;
+            }
+            if (modifiers_differ) {
+                // Only the modifiers were added, removed or transformed. The slicing step is invalidated, but the PrintObjects
+                // are kept with their layers, so that just the layers touched by the old or by the new modifiers are sliced again.
+                // First stop background processing before shuffling or deleting the ModelVolumes in the ModelObject's list.
+                this->call_cancel_callback();
+                auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
+                if (range.first != range.second) {
+                    // The regions are assigned to the volumes again in step 5). Remember the regions of the volumes,
+                    // which keep their slices, the reused layers are only valid if these regions do not change.
+                    std::vector<ModelObjectStatus::VolumeRegion> &volume_regions = const_cast<ModelObjectStatus&>(*it_status).volume_regions;
+                    const PrintObject *print_object = range.first->print_object;
+                    for (size_t region_id = 0; region_id < print_object->region_volumes.size(); ++ region_id)
+                        for (const std::pair<t_layer_height_range, int> &volume_and_range : print_object->region_volumes[region_id]) {
+                            const ModelVolume &volume = *model_object.volumes[volume_and_range.second];
+                            if (volume.is_modifier()) {
+                                auto it_volume = std::find_if(model_object_new.volumes.begin(), model_object_new.volumes.end(),
+                                    [&volume](const ModelVolume *volume_new) { return volume_new->id() == volume.id(); });
+                                if (it_volume == model_object_new.volumes.end() || ! (*it_volume)->is_modifier() ||
+                                    ! (*it_volume)->get_matrix().isApprox(volume.get_matrix()))
+                                    // Removed or transformed modifier, its layers are sliced again.
+                                    continue;
+                            }
+                            volume_regions.push_back({ volume.id(), volume_and_range.first, int(region_id), m_regions[region_id]->config() });
+                        }
+                }
+                for (auto it = range.first; it != range.second; ++ it) {
+                    update_apply_status(it->print_object->invalidate_modifiers(model_object_new));
+                    it->print_object->region_volumes.clear();
+                }
+            } else if (support_blockers_differ || support_enforcers_differ) {
+                // First stop background processing before shuffling or deleting the ModelVolumes in the ModelObject's list.
+                this->call_cancel_callback();
+                update_apply_status(false);
+                // Invalidate just the supports step.
+                auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
+                for (auto it = range.first; it != range.second; ++ it)
+                    update_apply_status(it->print_object->invalidate_step(posSupportMaterial));
+            }
+            if (modifiers_differ || support_blockers_differ || support_enforcers_differ)
+                // Copy just the modifier and support volumes.
+                model_volume_list_update_modifiers(model_object, model_object_new);
         }
-        if (! model_parts_differ && ! modifiers_differ) {
+        if (! model_parts_differ) {
             // Synchronize Object's config.
             bool object_config_changed = model_object.config != model_object_new.config;
 			if (object_config_changed)
@@ -1080,12 +1142,37 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
         }
     }
 
+    // Verify that the volumes keeping their slices after a change of the modifiers were assigned the same regions.
+    // Otherwise the layers kept by the PrintObject are sliced again from scratch.
+    for (PrintObject *print_object : m_objects) {
+        auto it_status = model_object_status.find(ModelObjectStatus(print_object->model_object()->id()));
+        assert(it_status != model_object_status.end());
+        for (const ModelObjectStatus::VolumeRegion &volume_region : it_status->volume_regions) {
+            bool found = false;
+            if (size_t(volume_region.region_id) < print_object->region_volumes.size())
+                for (const std::pair<t_layer_height_range, int> &volume_and_range : print_object->region_volumes[volume_region.region_id])
+                    if (print_object->model_object()->volumes[volume_and_range.second]->id() == volume_region.volume_id &&
+                        std::abs(volume_and_range.first.first  - volume_region.layer_range.first)  < EPSILON &&
+                        std::abs(volume_and_range.first.second - volume_region.layer_range.second) < EPSILON) {
+                        found = true;
+                        break;
+                    }
+            if (! found || ! m_regions[volume_region.region_id]->config().equals(volume_region.config)) {
+                update_apply_status(print_object->invalidate_step(posSlice));
+                break;
+            }
+        }
+    }
+
     // Update SlicingParameters for each object where the SlicingParameters is not valid.
     // If it is not valid, then it is ensured that PrintObject.m_slicing_params is not in use
     // (posSlicing and posSupportMaterial was invalidated).
     for (PrintObject *object : m_objects)
         object->update_slicing_parameters();
 
+    // The ModelVolumes deleted from m_model above released their meshes.
+    this->slicing_topology_release_unused();
+
 #ifdef _DEBUG
     check_model_ids_equal(m_model, model);
 #endif /* _DEBUG */
@@ -1804,33 +1891,72 @@ void Print::_make_wipe_tower()
     // Lets go through the wipe tower layers and determine pairs of extruder changes for each
     // to pass to wipe_tower (so that it can use it for planning the layout of the tower)
     {
+        // A single tool change to be planned on the wipe tower.
+        struct ToolChange {
+            unsigned int old_extruder;
+            unsigned int new_extruder;
+            bool         brim;
+            float        volume_to_wipe;
+        };
+        // Tool changes of a single wipe tower layer.
+        struct LayerToolChanges {
+            LayerTools              *layer_tools;
+            std::vector<ToolChange>  tool_changes;
+        };
+        std::vector<LayerToolChanges> layers;
+
+        // The sequence of tool changes is given by the extruders of the layers only, collect it first.
         unsigned int current_extruder_id = m_wipe_tower_data.tool_ordering.all_extruders().back();
         for (auto &layer_tools : m_wipe_tower_data.tool_ordering.layer_tools()) { // for all layers
             if (!layer_tools.has_wipe_tower) continue;
             bool first_layer = &layer_tools == &m_wipe_tower_data.tool_ordering.front();
-            wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, current_extruder_id, false);
+            layers.push_back({ &layer_tools, {} });
             for (const auto extruder_id : layer_tools.extruders) {
                 if ((first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back()) || extruder_id != current_extruder_id) {
-                    float volume_to_wipe = wipe_volumes[current_extruder_id][extruder_id];             // total volume to wipe after this toolchange
-                    // Not all of that can be used for infill purging:
-                    volume_to_wipe -= (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(extruder_id);
-
-                    // try to assign some infills/objects for the wiping:
-                    volume_to_wipe = layer_tools.wiping_extrusions().mark_wiping_extrusions(*this, current_extruder_id, extruder_id, volume_to_wipe);
-
-                    // add back the minimal amount toforce on the wipe tower:
-                    volume_to_wipe += (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(extruder_id);
-
-                    // request a toolchange at the wipe tower with at least volume_to_wipe purging amount
-                    wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, extruder_id,
-                                               first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back(), volume_to_wipe);
+                    layers.back().tool_changes.push_back({ current_extruder_id, extruder_id, first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back(), 0.f });
                     current_extruder_id = extruder_id;
                 }
             }
-            layer_tools.wiping_extrusions().ensure_perimeters_infills_order(*this);
             if (&layer_tools == &m_wipe_tower_data.tool_ordering.back() || (&layer_tools + 1)->wipe_tower_partitions == 0)
                 break;
         }
+
+        // Assigning the extrusions to be used for wiping only touches the extrusions of a single layer,
+        // therefore the layers are processed in parallel.
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, layers.size()),
+            [this, &layers, &wipe_volumes](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    this->throw_if_canceled();
+                    LayerToolChanges &layer = layers[layer_idx];
+                    for (ToolChange &tool_change : layer.tool_changes) {
+                        float volume_to_wipe = wipe_volumes[tool_change.old_extruder][tool_change.new_extruder];             // total volume to wipe after this toolchange
+                        // Not all of that can be used for infill purging:
+                        volume_to_wipe -= (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(tool_change.new_extruder);
+
+                        // try to assign some infills/objects for the wiping:
+                        volume_to_wipe = layer.layer_tools->wiping_extrusions().mark_wiping_extrusions(*this, tool_change.old_extruder, tool_change.new_extruder, volume_to_wipe);
+
+                        // add back the minimal amount toforce on the wipe tower:
+                        tool_change.volume_to_wipe = volume_to_wipe + (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(tool_change.new_extruder);
+                    }
+                    layer.layer_tools->wiping_extrusions().ensure_perimeters_infills_order(*this);
+                }
+            });
+        this->throw_if_canceled();
+
+        // Plan the tool changes at the wipe tower in the order of the layers.
+        current_extruder_id = m_wipe_tower_data.tool_ordering.all_extruders().back();
+        for (const LayerToolChanges &layer : layers) {
+            const LayerTools &layer_tools = *layer.layer_tools;
+            wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, current_extruder_id, false);
+            for (const ToolChange &tool_change : layer.tool_changes) {
+                // request a toolchange at the wipe tower with at least volume_to_wipe purging amount
+                wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, tool_change.old_extruder, tool_change.new_extruder,
+                                           tool_change.brim, tool_change.volume_to_wipe);
+                current_extruder_id = tool_change.new_extruder;
+            }
+        }
     }
 
     // Generate the wipe tower layers.
@@ -1868,6 +1994,43 @@ int Print::get_extruder(const ExtrusionEntityCollection& fill, const PrintRegion
                                     std::max<int>(region.config().perimeter_extruder.value - 1, 0);
 }
 
+Print::SlicingTopology Print::slicing_topology(const std::shared_ptr<const TriangleMesh> &mesh)
+{
+    std::lock_guard<std::mutex> lock(m_slicing_topology_mutex);
+    SlicingTopologyCacheEntry &entry = m_slicing_topology_cache[mesh.get()];
+    // The entry may be left over from a released mesh, which was allocated at the same address.
+    if (entry.source.lock() != mesh) {
+        std::shared_ptr<const TriangleMesh> mesh_shared_vertices;
+        if (! mesh->has_shared_vertices()) {
+            // TriangleMeshSlicer needs the shared vertices.
+            auto mesh_copy = std::make_shared<TriangleMesh>(*mesh);
+            mesh_copy->require_shared_vertices();
+            mesh_shared_vertices = std::move(mesh_copy);
+        }
+        // The source mesh is kept alive by the caller's ModelVolume, the entry does not hold another reference to it.
+        // The source is assigned last, so that a cancellation does not leave a half initialized entry.
+        entry.facets_edges = TriangleMeshSlicer::make_facets_edges(
+            (mesh_shared_vertices ? mesh_shared_vertices : mesh)->its, [this](){ this->throw_if_canceled(); });
+        entry.mesh_shared_vertices = std::move(mesh_shared_vertices);
+        entry.source               = mesh;
+    }
+    SlicingTopology out;
+    out.mesh         = entry.mesh_shared_vertices ? entry.mesh_shared_vertices : mesh;
+    out.facets_edges = entry.facets_edges;
+    return out;
+}
+
+// Release the slicing topologies of meshes, which are no more referenced by any ModelVolume.
+void Print::slicing_topology_release_unused()
+{
+    std::lock_guard<std::mutex> lock(m_slicing_topology_mutex);
+    for (auto it = m_slicing_topology_cache.begin(); it != m_slicing_topology_cache.end();)
+        if (it->second.source.expired())
+            it = m_slicing_topology_cache.erase(it);
+        else
+            ++ it;
+}
+
 // Generate a recommended G-code output file name based on the format template, default extension, and template parameters
 // (timestamps, object placeholders derived from the model, current placeholder prameters and print statistics.
 // Use the final print statistics if available, or just keep the print statistics placeholders if not available yet (before G-code is finalized).
@@ -12,6 +12,9 @@
 #include "GCode/ToolOrdering.hpp"
 #include "GCode/WipeTower.hpp"
 
+#include <map>
+#include <mutex>
+
 namespace Slic3r {
 
 class Print;
@@ -160,6 +163,14 @@ protected:
     bool                    invalidate_step(PrintObjectStep step);
     // Invalidates all PrintObject and Print steps.
     bool                    invalidate_all_steps();
+    // Invalidates all PrintObject and Print steps after the layer height profile or the layer height ranges changed.
+    // Contrary to invalidate_all_steps(), the layers and the regions are kept, so that slice() may reuse the bottom layers
+    // below the first modified layer with their perimeters and infill. To be called with the background processing stopped.
+    bool                    invalidate_layer_heights();
+    // Invalidates all PrintObject and Print steps after the modifier volumes of model_object() were added, removed or transformed
+    // to become the modifiers of model_object_new. The layers are kept, slice() re-slices just the layers touched by the old
+    // or by the new modifiers. To be called with the background processing stopped, before the model_object() is updated.
+    bool                    invalidate_modifiers(const ModelObject &model_object_new);
     // Invalidate steps based on a set of parameters changed.
     bool                    invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys);
     // If ! m_slicing_params.valid, recalculate.
@@ -174,9 +185,11 @@ private:
     void infill();
     void generate_support_material();
 
-    void _slice(const std::vector<coordf_t> &layer_height_profile);
-    std::string _fix_slicing_errors();
-    void _simplify_slices(double distance);
+    // Returns the indices of the layers sliced, the other layers were reused.
+    std::vector<size_t> _slice(const std::vector<coordf_t> &layer_height_profile);
+    // Removing the empty bottom layers shifts the indices of the sliced layers.
+    std::string _fix_slicing_errors(std::vector<size_t> &layers);
+    void _simplify_slices(double distance, const std::vector<size_t> &layers);
     void _make_perimeters();
     bool has_support_material() const;
     void detect_surfaces_type();
@@ -187,6 +200,10 @@ private:
     void discover_horizontal_shells();
     void combine_infill();
     void _generate_support_material();
+    // Mark all layers of the finished steps as reusable, see invalidate_layer_heights() and invalidate_modifiers().
+    void update_reusable_layers();
+    // Clear the reusable infill flags of the layers, whose fill surfaces may be changed by prepare_infill() due to the layers with new perimeters.
+    void update_reusable_infill();
 
     PrintObjectConfig                       m_config;
     // Translation in Z + Rotation + Scaling / Mirroring.
@@ -201,6 +218,12 @@ private:
     SlicingParameters                       m_slicing_params;
     LayerPtrs                               m_layers;
     SupportLayerPtrs                        m_support_layers;
+    // Flags of the layers with valid slices, perimeters and infill, which the next slicing may reuse if just the layer heights
+    // or the modifiers of the object changed, see invalidate_layer_heights() and invalidate_modifiers().
+    // The layers past the end of a vector are not reusable.
+    std::vector<char>                       m_reusable_slices;
+    std::vector<char>                       m_reusable_perimeters;
+    std::vector<char>                       m_reusable_infill;
 
     std::vector<ExPolygons> slice_region(size_t region_id, const std::vector<float> &z) const;
     std::vector<ExPolygons> slice_modifiers(size_t region_id, const std::vector<float> &z) const;
@@ -383,7 +406,18 @@ private:
     void                _simplify_slices(double distance);
 
     // Declared here to have access to Model / ModelObject / ModelInstance
-    static void         model_volume_list_update_supports(ModelObject &model_object_dst, const ModelObject &model_object_src);
+    static void         model_volume_list_update_modifiers(ModelObject &model_object_dst, const ModelObject &model_object_src);
+
+    // Mesh of a ModelVolume with shared vertices and its slicing topology. The topology does not depend
+    // on the transformation, it is reused by PrintObject::slice_volume() as long as the mesh is alive.
+    struct SlicingTopology {
+        std::shared_ptr<const TriangleMesh>     mesh;
+        TriangleMeshSlicer::FacetsEdgesPtr      facets_edges;
+    };
+    // Called by PrintObject::slice_volume().
+    SlicingTopology     slicing_topology(const std::shared_ptr<const TriangleMesh> &mesh);
+    // Called by Print::apply() and Print::clear() once the ModelVolumes were synchronized.
+    void                slicing_topology_release_unused();
 
     PrintConfig                             m_config;
     PrintObjectConfig                       m_default_object_config;
@@ -401,6 +435,17 @@ private:
     // Estimated print time, filament consumed.
     PrintStatistics                         m_print_statistics;
 
+    // Slicing topology of the ModelVolume meshes, indexed by the ModelVolume mesh.
+    struct SlicingTopologyCacheEntry {
+        // Source mesh, not owned. The entry is released once the source mesh is released by all ModelVolumes.
+        std::weak_ptr<const TriangleMesh>       source;
+        // Copy of the source mesh with shared vertices, if the source mesh does not have them.
+        std::shared_ptr<const TriangleMesh>     mesh_shared_vertices;
+        TriangleMeshSlicer::FacetsEdgesPtr      facets_edges;
+    };
+    std::map<const TriangleMesh*, SlicingTopologyCacheEntry> m_slicing_topology_cache;
+    std::mutex                              m_slicing_topology_mutex;
+
     // To allow GCode to set the Print's GCodeExport step status.
     friend class GCode;
     // Allow PrintObject to access m_mutex and m_cancel_callback.
@@ -317,6 +317,8 @@ public:
 
     const PlaceholderParser&   placeholder_parser() const { return m_placeholder_parser; }
     const DynamicPrintConfig&  full_print_config() const { return m_full_print_config; }
+    // Serialized values of full_print_config(), reused by the consecutive G-code exports.
+    ConfigSerializationCache&  config_serialization_cache() const { return m_config_serialization_cache; }
 
     virtual std::string        output_filename(const std::string &filename_base = std::string()) const = 0;
     // If the filename_base is set, it is used as the input for the template processing. In that case the path is expected to be the directory (may be empty).
@@ -343,6 +345,7 @@ protected:
 	Model                                   m_model;
 	DynamicPrintConfig						m_full_print_config;
     PlaceholderParser                       m_placeholder_parser;
+    mutable ConfigSerializationCache        m_config_serialization_cache;
 
 private:
     tbb::atomic<CancelStatus>               m_cancel_status;
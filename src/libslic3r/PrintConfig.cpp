@@ -1441,6 +1441,15 @@ void PrintConfigDef::init_fff_params()
     def->mode = comExpert;
     def->set_default_value(new ConfigOptionStrings());
 
+    def = this->add("post_process_streaming", coBool);
+    def->label = L("Run scripts as filters");
+    def->tooltip = L("If enabled, the post-processing scripts are chained as filters reading the G-code "
+                   "from their standard input and writing the modified G-code to their standard output. "
+                   "The scripts run concurrently and the output file is written just once. "
+                   "Not supported on Windows.");
+    def->mode = comExpert;
+    def->set_default_value(new ConfigOptionBool(false));
+
     def = this->add("printer_model", coString);
     def->label = L("Printer type");
     def->tooltip = L("Type of the printer.");
@@ -40,6 +40,12 @@
 
 namespace Slic3r {
 
+// Is the layer marked as reusable by one of PrintObject::m_reusable_slices, m_reusable_perimeters, m_reusable_infill?
+static inline bool layer_reusable(const std::vector<char> &reusable, size_t idx_layer)
+{
+    return idx_layer < reusable.size() && reusable[idx_layer];
+}
+
 PrintObject::PrintObject(Print* print, ModelObject* model_object, bool add_instances) :
     PrintObjectBaseWithState(print, model_object),
     typed_slices(false),
@@ -111,17 +117,17 @@ void PrintObject::slice()
     std::vector<coordf_t> layer_height_profile;
     this->update_layer_height_profile(*this->model_object(), m_slicing_params, layer_height_profile);
     m_print->throw_if_canceled();
-    this->_slice(layer_height_profile);
+    std::vector<size_t> layers_sliced = this->_slice(layer_height_profile);
     m_print->throw_if_canceled();
     // Fix the model.
     //FIXME is this the right place to do? It is done repeateadly at the UI and now here at the backend.
-    std::string warning = this->_fix_slicing_errors();
+    std::string warning = this->_fix_slicing_errors(layers_sliced);
     m_print->throw_if_canceled();
     if (! warning.empty())
         BOOST_LOG_TRIVIAL(info) << warning;
     // Simplify slices if required.
     if (m_print->config().resolution)
-        this->_simplify_slices(scale_(this->print()->config().resolution));
+        this->_simplify_slices(scale_(this->print()->config().resolution), layers_sliced);
     if (m_layers.empty())
         throw std::runtime_error("No layers were detected. You might want to repair your STL file(s) or check their size or thickness and retry.\n");    
     this->set_done(posSlice);
@@ -149,6 +155,15 @@ void PrintObject::make_perimeters()
         }
         this->typed_slices = false;
     }
+
+    // The perimeters of the layers kept by slice() after a change of the layer heights or of the modifiers are reused.
+    std::vector<size_t> layers_to_process;
+    layers_to_process.reserve(m_layers.size());
+    for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx)
+        if (! layer_reusable(m_reusable_perimeters, layer_idx))
+            layers_to_process.emplace_back(layer_idx);
+    if (layers_to_process.size() < m_layers.size())
+        BOOST_LOG_TRIVIAL(debug) << "Generating perimeters - reusing perimeters of " << m_layers.size() - layers_to_process.size() << " layers";
     
     // compare each layer to the one below, and mark those slices needing
     // one additional inner perimeter, like the top of domed objects-
@@ -164,9 +179,13 @@ void PrintObject::make_perimeters()
 
         BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - start";
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size() - 1),
-            [this, &region, region_id](const tbb::blocked_range<size_t>& range) {
-                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+            tbb::blocked_range<size_t>(0, layers_to_process.size()),
+            [this, &region, region_id, &layers_to_process](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++ i) {
+                    size_t layer_idx = layers_to_process[i];
+                    if (layer_idx + 1 == m_layers.size())
+                        // The topmost layer has no upper layer to be compared with.
+                        continue;
                     m_print->throw_if_canceled();
                     LayerRegion &layerm                     = *m_layers[layer_idx]->m_regions[region_id];
                     const LayerRegion &upper_layerm         = *m_layers[layer_idx+1]->m_regions[region_id];
@@ -222,11 +241,11 @@ void PrintObject::make_perimeters()
 
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
-        [this](const tbb::blocked_range<size_t>& range) {
-            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+        tbb::blocked_range<size_t>(0, layers_to_process.size()),
+        [this, &layers_to_process](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i) {
                 m_print->throw_if_canceled();
-                m_layers[layer_idx]->make_perimeters();
+                m_layers[layers_to_process[i]]->make_perimeters();
             }
         }
     );
@@ -250,6 +269,15 @@ void PrintObject::prepare_infill()
 
     m_print->set_status(30, L("Preparing infill"));
 
+    // The fill surfaces of the layers with reused perimeters were modified by the last run of prepare_infill().
+    // Restore them from the fill_expolygons produced together with the perimeters by Layer::make_perimeters().
+    // The infill of the layers is reused if their fill surfaces could not be affected by the modified layers.
+    this->update_reusable_infill();
+    for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx)
+        if (layer_reusable(m_reusable_perimeters, layer_idx))
+            for (LayerRegion *layerm : m_layers[layer_idx]->m_regions)
+                layerm->fill_surfaces.set(layerm->fill_expolygons, stInternal);
+
     // This will assign a type (top/bottom/internal) to $layerm->slices.
     // Then the classifcation of $layerm->slices is transfered onto 
     // the $layerm->fill_surfaces by clipping $layerm->fill_surfaces
@@ -364,13 +392,19 @@ void PrintObject::infill()
     this->prepare_infill();
 
     if (this->set_started(posInfill)) {
-        BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
+        // The infill of the layers not affected by a change of the layer heights or of the modifiers is reused, see prepare_infill().
+        std::vector<size_t> layers_to_process;
+        layers_to_process.reserve(m_layers.size());
+        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx)
+            if (! layer_reusable(m_reusable_infill, layer_idx))
+                layers_to_process.emplace_back(layer_idx);
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start, reusing infill of " << m_layers.size() - layers_to_process.size() << " layers";
         tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size()),
-            [this](const tbb::blocked_range<size_t>& range) {
-                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+            tbb::blocked_range<size_t>(0, layers_to_process.size()),
+            [this, &layers_to_process](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++ i) {
                     m_print->throw_if_canceled();
-                    m_layers[layer_idx]->make_fills();
+                    m_layers[layers_to_process[i]]->make_fills();
                 }
             }
         );
@@ -409,6 +443,9 @@ void PrintObject::clear_layers()
     for (Layer *l : m_layers)
         delete l;
     m_layers.clear();
+    m_reusable_slices.clear();
+    m_reusable_perimeters.clear();
+    m_reusable_infill.clear();
 }
 
 Layer* PrintObject::add_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
@@ -561,6 +598,16 @@ bool PrintObject::invalidate_state_by_config_options(const std::vector<t_config_
 bool PrintObject::invalidate_step(PrintObjectStep step)
 {
 	bool invalidated = Inherited::invalidate_step(step);
+
+    // The layers can no more be reused with the results of the invalidated steps, see invalidate_layer_heights().
+    if (step == posSlice)
+        m_reusable_slices.clear();
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill)
+        // prepare_infill() restores the fill surfaces of the layers with reused perimeters, which is only valid
+        // if make_perimeters() regenerated the perimeters of the other layers.
+        m_reusable_perimeters.clear();
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill || step == posInfill)
+        m_reusable_infill.clear();
     
     // propagate to dependent steps
     if (step == posPerimeters) {
@@ -595,9 +642,116 @@ bool PrintObject::invalidate_all_steps()
 	// Then reset some of the depending values.
 	this->m_slicing_params.valid = false;
 	this->region_volumes.clear();
+    m_reusable_slices.clear();
+    m_reusable_perimeters.clear();
+    m_reusable_infill.clear();
 	return result;
 }
 
+bool PrintObject::invalidate_layer_heights()
+{
+    // Layers of the steps finished by the last run may be reused. If the last run was interrupted, the reusable layers
+    // were already reduced by the interrupted steps to the layers they did not touch.
+    this->update_reusable_layers();
+    bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
+    this->m_slicing_params.valid = false;
+    return result;
+}
+
+bool PrintObject::invalidate_modifiers(const ModelObject &model_object_new)
+{
+    // Bounding boxes of the modifiers removed, added or transformed, in the coordinate system of the slicing.
+    std::vector<BoundingBoxf3> bboxes;
+    auto collect_changed_modifiers = [this, &bboxes](const ModelObject &model_object, const ModelObject &model_object_other) {
+        for (const ModelVolume *volume : model_object.volumes)
+            if (volume->is_modifier()) {
+                auto it = std::find_if(model_object_other.volumes.begin(), model_object_other.volumes.end(),
+                    [volume](const ModelVolume *volume_other) { return volume_other->id() == volume->id(); });
+                if (it == model_object_other.volumes.end() || ! (*it)->is_modifier() || ! (*it)->get_matrix().isApprox(volume->get_matrix()))
+                    bboxes.emplace_back(volume->mesh().transformed_bounding_box(m_trafo * volume->get_matrix()));
+            }
+    };
+    collect_changed_modifiers(*this->model_object(), model_object_new);
+    collect_changed_modifiers(model_object_new, *this->model_object());
+
+    this->update_reusable_layers();
+    if (m_config.xy_size_compensation.value != 0.)
+        // The XY size compensation is applied differently to objects with and without modifiers, slice all the layers again.
+        m_reusable_slices.clear();
+    // Slice again the layers, whose slices may intersect the old or the new modifiers.
+    // The footprints of the modifiers are tested against the bounding boxes of the layer slices.
+    for (size_t idx_layer = 0; idx_layer < m_reusable_slices.size() && idx_layer < m_layers.size(); ++ idx_layer)
+        if (m_reusable_slices[idx_layer]) {
+            const Layer *layer      = m_layers[idx_layer];
+            BoundingBox  bbox_layer = get_extents(layer->slices.expolygons);
+            if (idx_layer == 0)
+                // The slices of the first layer were shrunk by the elephant foot compensation.
+                bbox_layer.offset(scale_(m_config.elefant_foot_compensation.value));
+            for (const BoundingBoxf3 &bbox : bboxes)
+                if (layer->slice_z > bbox.min.z() - EPSILON && layer->slice_z < bbox.max.z() + EPSILON &&
+                    bbox_layer.overlap(BoundingBox(
+                        Point(Point::new_scale(bbox.min.x(), bbox.min.y()) - m_copies_shift),
+                        Point(Point::new_scale(bbox.max.x(), bbox.max.y()) - m_copies_shift)))) {
+                    m_reusable_slices[idx_layer] = false;
+                    break;
+                }
+        }
+    bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
+    this->m_slicing_params.valid = false;
+    return result;
+}
+
+void PrintObject::update_reusable_layers()
+{
+    if (this->is_step_done_unguarded(posSlice))
+        m_reusable_slices.assign(m_layers.size(), true);
+    if (this->is_step_done_unguarded(posPerimeters))
+        m_reusable_perimeters.assign(m_layers.size(), true);
+    if (this->is_step_done_unguarded(posInfill))
+        m_reusable_infill.assign(m_layers.size(), true);
+}
+
+// Clear the reusable infill flags of the layers, whose fill surfaces may be changed by prepare_infill() due to the layers with new perimeters.
+void PrintObject::update_reusable_infill()
+{
+    if (m_reusable_infill.empty())
+        return;
+    // clip_fill_surfaces() propagates the sparse infill from the top of the object down to its bottom.
+    if (m_config.infill_only_where_needed.value) {
+        m_reusable_infill.clear();
+        return;
+    }
+    // detect_surfaces_type() and process_external_surfaces() look at the neighbor layers, discover_vertical_shells()
+    // and discover_horizontal_shells() as far as the solid layers reach, combine_infill() merges up to infill_every_layers layers.
+    // bridge_over_infill() removes the sparse infill below a bridge down to the height of the bridging flow.
+    int    max_solid_layers  = 0;
+    int    max_every_layers  = 1;
+    double max_bridge_height = 0.;
+    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id)
+        if (! this->region_volumes[region_id].empty()) {
+            const PrintRegion &region = *m_print->regions()[region_id];
+            max_solid_layers  = std::max(max_solid_layers, std::max(region.config().top_solid_layers.value, region.config().bottom_solid_layers.value));
+            max_every_layers  = std::max(max_every_layers, region.config().infill_every_layers.value);
+            max_bridge_height = std::max(max_bridge_height, double(region.flow(frSolidInfill, -1, true, false, -1, *this).height));
+        }
+    size_t num_layers = 2 + 2 * size_t(max_solid_layers) + size_t(max_every_layers);
+    // Upper end of the range of layers, whose infill was cleared already.
+    size_t cleared_end = 0;
+    for (size_t layer_idx = 0; layer_idx < m_layers.size() && layer_idx < m_reusable_infill.size() + num_layers; ++ layer_idx)
+        if (! layer_reusable(m_reusable_perimeters, layer_idx)) {
+            size_t first_layer = layer_idx - std::min(layer_idx, num_layers);
+            if (first_layer > 0) {
+                coordf_t bottom_z = m_layers[first_layer]->print_z - max_bridge_height;
+                while (first_layer > 0 && m_layers[first_layer - 1]->print_z >= bottom_z)
+                    -- first_layer;
+            }
+            size_t last_layer = std::min(layer_idx + num_layers + 1, m_reusable_infill.size());
+            for (size_t i = std::max(first_layer, cleared_end); i < last_layer; ++ i)
+                m_reusable_infill[i] = false;
+            cleared_end = std::max(cleared_end, last_layer);
+        }
+}
+
 bool PrintObject::has_support_material() const
 {
     return m_config.support_material
@@ -1216,6 +1370,22 @@ void PrintObject::bridge_over_infill()
 {
     BOOST_LOG_TRIVIAL(info) << "Bridge over infill..." << log_memory_info();
 
+    // Bridging of a layer only modifies the stInternalSolid / stInternalBridge surfaces of that layer,
+    // while it reads the stInternal surfaces of the layers below, which are not modified here.
+    // Collect the stInternal surfaces of all regions of each layer first, so that the layers may be processed
+    // in parallel without reading the fill_surfaces being modified by another thread.
+    std::vector<Polygons> layers_internal;
+    if (std::any_of(m_print->regions().begin(), m_print->regions().end(), [](const PrintRegion *region){ return region->config().fill_density.value < 100; })) {
+        layers_internal.assign(m_layers.size(), Polygons());
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, m_layers.size()),
+            [this, &layers_internal](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
+                    for (LayerRegion *layerm : m_layers[layer_idx]->m_regions)
+                        layerm->fill_surfaces.filter_by_type(stInternal, &layers_internal[layer_idx]);
+            });
+    }
+
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
         const PrintRegion &region = *m_print->regions()[region_id];
         
@@ -1232,110 +1402,108 @@ void PrintObject::bridge_over_infill()
             *this
         );
         
-		for (LayerPtrs::iterator layer_it = m_layers.begin(); layer_it != m_layers.end(); ++ layer_it) {
+        BOOST_LOG_TRIVIAL(debug) << "Bridge over infill - region " << region_id << " in parallel - start";
+        tbb::parallel_for(
             // skip first layer
-			if (layer_it == m_layers.begin())
-                continue;
-            
-            Layer* layer        = *layer_it;
-            LayerRegion* layerm = layer->m_regions[region_id];
+            tbb::blocked_range<size_t>(1, std::max<size_t>(1, m_layers.size())),
+            [this, region_id, &bridge_flow, &layers_internal](const tbb::blocked_range<size_t>& range) {
+                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                    m_print->throw_if_canceled();
+                    Layer* layer        = m_layers[layer_idx];
+                    LayerRegion* layerm = layer->m_regions[region_id];
             
-            // extract the stInternalSolid surfaces that might be transformed into bridges
-            Polygons internal_solid;
-            layerm->fill_surfaces.filter_by_type(stInternalSolid, &internal_solid);
+                    // extract the stInternalSolid surfaces that might be transformed into bridges
+                    Polygons internal_solid;
+                    layerm->fill_surfaces.filter_by_type(stInternalSolid, &internal_solid);
             
-            // check whether the lower area is deep enough for absorbing the extra flow
-            // (for obvious physical reasons but also for preventing the bridge extrudates
-            // from overflowing in 3D preview)
-            ExPolygons to_bridge;
-            {
-                Polygons to_bridge_pp = internal_solid;
+                    // check whether the lower area is deep enough for absorbing the extra flow
+                    // (for obvious physical reasons but also for preventing the bridge extrudates
+                    // from overflowing in 3D preview)
+                    ExPolygons to_bridge;
+                    {
+                        Polygons to_bridge_pp = internal_solid;
                 
-                // iterate through lower layers spanned by bridge_flow
-                double bottom_z = layer->print_z - bridge_flow.height;
-                for (int i = int(layer_it - m_layers.begin()) - 1; i >= 0; --i) {
-                    const Layer* lower_layer = m_layers[i];
-                    
-                    // stop iterating if layer is lower than bottom_z
-                    if (lower_layer->print_z < bottom_z) break;
+                        // iterate through lower layers spanned by bridge_flow
+                        double bottom_z = layer->print_z - bridge_flow.height;
+                        for (int i = int(layer_idx) - 1; i >= 0; --i) {
+                            const Layer* lower_layer = m_layers[i];
                     
-                    // iterate through regions and collect internal surfaces
-                    Polygons lower_internal;
-                    for (LayerRegion *lower_layerm : lower_layer->m_regions)
-                        lower_layerm->fill_surfaces.filter_by_type(stInternal, &lower_internal);
+                            // stop iterating if layer is lower than bottom_z
+                            if (lower_layer->print_z < bottom_z) break;
                     
-                    // intersect such lower internal surfaces with the candidate solid surfaces
-                    to_bridge_pp = intersection(to_bridge_pp, lower_internal);
-                }
+                            // intersect the internal surfaces of all regions of the lower layer with the candidate solid surfaces
+                            to_bridge_pp = intersection(to_bridge_pp, layers_internal[i]);
+                        }
                 
-                // there's no point in bridging too thin/short regions
-                //FIXME Vojtech: The offset2 function is not a geometric offset, 
-                // therefore it may create 1) gaps, and 2) sharp corners, which are outside the original contour.
-                // The gaps will be filled by a separate region, which makes the infill less stable and it takes longer.
-                {
-                    float min_width = float(bridge_flow.scaled_width()) * 3.f;
-                    to_bridge_pp = offset2(to_bridge_pp, -min_width, +min_width);
-                }
+                        // there's no point in bridging too thin/short regions
+                        //FIXME Vojtech: The offset2 function is not a geometric offset, 
+                        // therefore it may create 1) gaps, and 2) sharp corners, which are outside the original contour.
+                        // The gaps will be filled by a separate region, which makes the infill less stable and it takes longer.
+                        {
+                            float min_width = float(bridge_flow.scaled_width()) * 3.f;
+                            to_bridge_pp = offset2(to_bridge_pp, -min_width, +min_width);
+                        }
                 
-                if (to_bridge_pp.empty()) continue;
+                        if (to_bridge_pp.empty()) continue;
                 
-                // convert into ExPolygons
-                to_bridge = union_ex(to_bridge_pp);
-            }
+                        // convert into ExPolygons
+                        to_bridge = union_ex(to_bridge_pp);
+                    }
             
-            #ifdef SLIC3R_DEBUG
-            printf("Bridging " PRINTF_ZU " internal areas at layer " PRINTF_ZU "\n", to_bridge.size(), layer->id());
-            #endif
+                    #ifdef SLIC3R_DEBUG
+                    printf("Bridging " PRINTF_ZU " internal areas at layer " PRINTF_ZU "\n", to_bridge.size(), layer->id());
+                    #endif
             
-            // compute the remaning internal solid surfaces as difference
-            ExPolygons not_to_bridge = diff_ex(internal_solid, to_polygons(to_bridge), true);
-            to_bridge = intersection_ex(to_polygons(to_bridge), internal_solid, true);
-            // build the new collection of fill_surfaces
-            layerm->fill_surfaces.remove_type(stInternalSolid);
-            for (ExPolygon &ex : to_bridge)
-                layerm->fill_surfaces.surfaces.push_back(Surface(stInternalBridge, ex));
-            for (ExPolygon &ex : not_to_bridge)
-                layerm->fill_surfaces.surfaces.push_back(Surface(stInternalSolid, ex));            
-            /*
-            # exclude infill from the layers below if needed
-            # see discussion at https://github.com/alexrj/Slic3r/issues/240
-            # Update: do not exclude any infill. Sparse infill is able to absorb the excess material.
-            if (0) {
-                my $excess = $layerm->extruders->{infill}->bridge_flow->width - $layerm->height;
-                for (my $i = $layer_id-1; $excess >= $self->get_layer($i)->height; $i--) {
-                    Slic3r::debugf "  skipping infill below those areas at layer %d\n", $i;
-                    foreach my $lower_layerm (@{$self->get_layer($i)->regions}) {
-                        my @new_surfaces = ();
-                        # subtract the area from all types of surfaces
-                        foreach my $group (@{$lower_layerm->fill_surfaces->group}) {
-                            push @new_surfaces, map $group->[0]->clone(expolygon => $_),
-                                @{diff_ex(
-                                    [ map $_->p, @$group ],
-                                    [ map @$_, @$to_bridge ],
-                                )};
-                            push @new_surfaces, map Slic3r::Surface->new(
-                                expolygon       => $_,
-                                surface_type    => S_TYPE_INTERNALVOID,
-                            ), @{intersection_ex(
-                                [ map $_->p, @$group ],
-                                [ map @$_, @$to_bridge ],
-                            )};
+                    // compute the remaning internal solid surfaces as difference
+                    ExPolygons not_to_bridge = diff_ex(internal_solid, to_polygons(to_bridge), true);
+                    to_bridge = intersection_ex(to_polygons(to_bridge), internal_solid, true);
+                    // build the new collection of fill_surfaces
+                    layerm->fill_surfaces.remove_type(stInternalSolid);
+                    for (ExPolygon &ex : to_bridge)
+                        layerm->fill_surfaces.surfaces.push_back(Surface(stInternalBridge, ex));
+                    for (ExPolygon &ex : not_to_bridge)
+                        layerm->fill_surfaces.surfaces.push_back(Surface(stInternalSolid, ex));            
+                    /*
+                    # exclude infill from the layers below if needed
+                    # see discussion at https://github.com/alexrj/Slic3r/issues/240
+                    # Update: do not exclude any infill. Sparse infill is able to absorb the excess material.
+                    if (0) {
+                        my $excess = $layerm->extruders->{infill}->bridge_flow->width - $layerm->height;
+                        for (my $i = $layer_id-1; $excess >= $self->get_layer($i)->height; $i--) {
+                            Slic3r::debugf "  skipping infill below those areas at layer %d\n", $i;
+                            foreach my $lower_layerm (@{$self->get_layer($i)->regions}) {
+                                my @new_surfaces = ();
+                                # subtract the area from all types of surfaces
+                                foreach my $group (@{$lower_layerm->fill_surfaces->group}) {
+                                    push @new_surfaces, map $group->[0]->clone(expolygon => $_),
+                                        @{diff_ex(
+                                            [ map $_->p, @$group ],
+                                            [ map @$_, @$to_bridge ],
+                                        )};
+                                    push @new_surfaces, map Slic3r::Surface->new(
+                                        expolygon       => $_,
+                                        surface_type    => S_TYPE_INTERNALVOID,
+                                    ), @{intersection_ex(
+                                        [ map $_->p, @$group ],
+                                        [ map @$_, @$to_bridge ],
+                                    )};
+                                }
+                                $lower_layerm->fill_surfaces->clear;
+                                $lower_layerm->fill_surfaces->append($_) for @new_surfaces;
+                            }
+                    
+                            $excess -= $self->get_layer($i)->height;
                         }
-                        $lower_layerm->fill_surfaces->clear;
-                        $lower_layerm->fill_surfaces->append($_) for @new_surfaces;
                     }
-                    
-                    $excess -= $self->get_layer($i)->height;
-                }
-            }
-            */
+                    */
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-            layerm->export_region_slices_to_svg_debug("7_bridge_over_infill");
-            layerm->export_region_fill_surfaces_to_svg_debug("7_bridge_over_infill");
+                    layerm->export_region_slices_to_svg_debug("7_bridge_over_infill");
+                    layerm->export_region_fill_surfaces_to_svg_debug("7_bridge_over_infill");
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
-            m_print->throw_if_canceled();
-        }
+                }
+            });
+        BOOST_LOG_TRIVIAL(debug) << "Bridge over infill - region " << region_id << " in parallel - end";
     }
 }
 
@@ -1462,12 +1630,13 @@ bool PrintObject::update_layer_height_profile(const ModelObject &model_object, c
 // Resulting expolygons of layer regions are marked as Internal.
 //
 // this should be idempotent
-void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
+//
+// The layers left by the last slicing at the same heights are reused, see invalidate_layer_heights() and invalidate_modifiers().
+// Returns the indices of the layers sliced.
+std::vector<size_t> PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
 {
     BOOST_LOG_TRIVIAL(info) << "Slicing objects..." << log_memory_info();
 
-    this->typed_slices = false;
-
 #ifdef SLIC3R_PROFILE
     // Disable parallelization so the Shiny profiler works
     static tbb::task_scheduler_init *tbb_init = nullptr;
@@ -1475,20 +1644,77 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
 #endif
 
     // 1) Initialize layers and their slice heights.
-    std::vector<float> slice_zs;
+    // Indices of the layers to be sliced, the other layers keep their slices.
+    std::vector<size_t> layers_to_slice;
+    std::vector<float>  slice_zs;
     {
-        this->clear_layers();
         // Object layers (pairs of bottom/top Z coordinate), without the raft.
         std::vector<coordf_t> object_layers = generate_object_layers(m_slicing_params, layer_height_profile);
         // Reserve object layers for the raft. Last layer of the raft is the contact layer.
         int id = int(m_slicing_params.raft_layers());
-        slice_zs.reserve(object_layers.size());
-        Layer *prev = nullptr;
-        for (size_t i_layer = 0; i_layer < object_layers.size(); i_layer += 2) {
+        // Find the bottom layers sliced before at the same heights as the new layers, up to the topmost layer with reusable slices.
+        size_t num_reusable = std::min(m_reusable_slices.size(), std::min(m_layers.size(), object_layers.size() / 2));
+        while (num_reusable > 0 && ! m_reusable_slices[num_reusable - 1])
+            -- num_reusable;
+        size_t num_kept = 0;
+        for (; num_kept < num_reusable; ++ num_kept) {
+            const Layer *layer = m_layers[num_kept];
+            coordf_t     lo    = object_layers[2 * num_kept];
+            coordf_t     hi    = object_layers[2 * num_kept + 1];
+            if (layer->id() != size_t(id) + num_kept || std::abs(layer->height - (hi - lo)) > EPSILON ||
+                std::abs(layer->print_z - (hi + m_slicing_params.object_print_z_min)) > EPSILON || std::abs(layer->slice_z - 0.5 * (lo + hi)) > EPSILON)
+                break;
+        }
+        if (num_kept == 0)
+            this->clear_layers();
+        else {
+            BOOST_LOG_TRIVIAL(debug) << "Slicing objects - keeping " << num_kept << " of " << m_layers.size() << " layers";
+            for (size_t i = num_kept; i < m_layers.size(); ++ i)
+                delete m_layers[i];
+            m_layers.erase(m_layers.begin() + num_kept, m_layers.end());
+            m_layers.back()->upper_layer = nullptr;
+            // The kept layers are to be processed by make_perimeters() as if they were just sliced.
+            if (this->typed_slices)
+                for (Layer *layer : m_layers)
+                    layer->merge_slices();
+            // The elephant foot compensation is applied differently to a single region and to multiple regions.
+            if ((m_layers.front()->region_count() == 1) != (this->region_volumes.size() == 1))
+                m_reusable_slices.front() = false;
+            m_reusable_slices.resize(num_kept);
+            if (m_reusable_perimeters.size() > num_kept)
+                m_reusable_perimeters.resize(num_kept);
+            if (m_reusable_infill.size() > num_kept)
+                m_reusable_infill.resize(num_kept);
+            for (size_t idx_layer = 0; idx_layer < num_kept; ++ idx_layer) {
+                Layer *layer = m_layers[idx_layer];
+                // Make sure the kept layers contain layer region objects for all regions.
+                // The regions past the regions of this object were only assigned to the removed modifiers.
+                layer->trim_regions(this->region_volumes.size());
+                for (size_t region_id = layer->region_count(); region_id < this->region_volumes.size(); ++ region_id)
+                    layer->add_region(this->print()->regions()[region_id]);
+                if (! m_reusable_slices[idx_layer]) {
+                    // Slice the layer again.
+                    for (LayerRegion *layerm : layer->m_regions)
+                        layerm->slices.clear();
+                    layer->slicing_errors = false;
+                    layers_to_slice.emplace_back(idx_layer);
+                    slice_zs.emplace_back(float(layer->slice_z));
+                }
+            }
+            if (layers_to_slice.size() < num_kept)
+                BOOST_LOG_TRIVIAL(debug) << "Slicing objects - reusing slices of " << num_kept - layers_to_slice.size() << " layers";
+        }
+        this->typed_slices = false;
+        id += int(m_layers.size());
+        layers_to_slice.reserve(layers_to_slice.size() + object_layers.size() / 2 - m_layers.size());
+        slice_zs.reserve(slice_zs.size() + object_layers.size() / 2 - m_layers.size());
+        Layer *prev = m_layers.empty() ? nullptr : m_layers.back();
+        for (size_t i_layer = 2 * m_layers.size(); i_layer < object_layers.size(); i_layer += 2) {
             coordf_t lo = object_layers[i_layer];
             coordf_t hi = object_layers[i_layer + 1];
             coordf_t slice_z = 0.5 * (lo + hi);
             Layer *layer = this->add_layer(id ++, hi - lo, hi + m_slicing_params.object_print_z_min, slice_z);
+            layers_to_slice.emplace_back(m_layers.size() - 1);
             slice_zs.push_back(float(slice_z));
             if (prev != nullptr) {
                 prev->upper_layer = layer;
@@ -1543,7 +1769,7 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
             m_print->throw_if_canceled();
             BOOST_LOG_TRIVIAL(debug) << "Slicing objects - append slices " << region_id << " start";
             for (size_t layer_id = 0; layer_id < expolygons_by_layer.size(); ++ layer_id)
-                m_layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons_by_layer[layer_id]), stInternal);
+                m_layers[layers_to_slice[layer_id]]->regions()[region_id]->slices.append(std::move(expolygons_by_layer[layer_id]), stInternal);
             m_print->throw_if_canceled();
             BOOST_LOG_TRIVIAL(debug) << "Slicing objects - append slices " << region_id << " end";
         }
@@ -1587,7 +1813,7 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
         BOOST_LOG_TRIVIAL(debug) << "Slicing objects - parallel clipping - start";
         tbb::parallel_for(
             tbb::blocked_range<size_t>(0, slice_zs.size()),
-            [this, &sliced_volumes, num_modifiers](const tbb::blocked_range<size_t>& range) {
+            [this, &sliced_volumes, num_modifiers, &layers_to_slice](const tbb::blocked_range<size_t>& range) {
                 float delta   = float(scale_(m_config.xy_size_compensation.value));
                 // Only upscale together with clipping if there are no modifiers, as the modifiers shall be applied before upscaling
                 // (upscaling may grow the object outside of the modifier mesh).
@@ -1622,7 +1848,7 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
                         if (num_volumes > 1)
                             // Merge the islands using a positive / negative offset.
                             expolygons = offset_ex(offset_ex(expolygons, float(scale_(EPSILON))), -float(scale_(EPSILON)));
-                        m_layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons), stInternal);
+                        m_layers[layers_to_slice[layer_id]]->regions()[region_id]->slices.append(std::move(expolygons), stInternal);
                     }
                 }
             });
@@ -1643,13 +1869,13 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
             // loop through the other regions and 'steal' the slices belonging to this one
             BOOST_LOG_TRIVIAL(debug) << "Slicing modifier volumes - stealing " << region_id << " start";
             tbb::parallel_for(
-                tbb::blocked_range<size_t>(0, m_layers.size()),
-				[this, &expolygons_by_layer, region_id](const tbb::blocked_range<size_t>& range) {
+                tbb::blocked_range<size_t>(0, slice_zs.size()),
+				[this, &expolygons_by_layer, region_id, &layers_to_slice](const tbb::blocked_range<size_t>& range) {
                     for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
                         for (size_t other_region_id = 0; other_region_id < this->region_volumes.size(); ++ other_region_id) {
                             if (region_id == other_region_id)
                                 continue;
-                            Layer       *layer = m_layers[layer_id];
+                            Layer       *layer = m_layers[layers_to_slice[layer_id]];
                             LayerRegion *layerm = layer->m_regions[region_id];
                             LayerRegion *other_layerm = layer->m_regions[other_region_id];
                             if (layerm == nullptr || other_layerm == nullptr || other_layerm->slices.empty() || expolygons_by_layer[layer_id].empty())
@@ -1683,13 +1909,20 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
     m_print->throw_if_canceled();
 end:
     ;
+    // Drop the removed layers.
+    while (! layers_to_slice.empty() && layers_to_slice.back() >= m_layers.size())
+        layers_to_slice.pop_back();
+    for (std::vector<char> *reusable : { &m_reusable_slices, &m_reusable_perimeters, &m_reusable_infill })
+        if (reusable->size() > m_layers.size())
+            reusable->resize(m_layers.size());
 
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - make_slices in parallel - begin";
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
-		[this, upscaled, clipped](const tbb::blocked_range<size_t>& range) {
-            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
+        tbb::blocked_range<size_t>(0, layers_to_slice.size()),
+		[this, upscaled, clipped, &layers_to_slice](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i) {
                 m_print->throw_if_canceled();
+                size_t layer_id = layers_to_slice[i];
                 Layer *layer = m_layers[layer_id];
                 // Apply size compensation and perform clipping of multi-part objects.
                 float delta = float(scale_(m_config.xy_size_compensation.value));
@@ -1783,6 +2016,12 @@ end:
         });
     m_print->throw_if_canceled();
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - make_slices in parallel - end";
+
+    // The perimeters of a layer depend on the slices of the layer above (extra perimeters) and of the layer below (overhangs).
+    for (size_t layer_id : layers_to_slice)
+        for (size_t i = (layer_id == 0) ? 0 : layer_id - 1; i <= layer_id + 1 && i < m_reusable_perimeters.size(); ++ i)
+            m_reusable_perimeters[i] = false;
+    return layers_to_slice;
 }
 
 // To be used only if there are no layer span specific configurations applied, which would lead to z ranges being generated for this region.
@@ -1907,6 +2146,8 @@ std::vector<ExPolygons> PrintObject::slice_support_volumes(const ModelVolumeType
 
 std::vector<ExPolygons> PrintObject::slice_volumes(const std::vector<float> &z, const std::vector<const ModelVolume*> &volumes) const
 {
+    if (volumes.size() == 1)
+        return this->slice_volume(z, *volumes.front());
     std::vector<ExPolygons> layers;
     if (! volumes.empty()) {
         // Compose mesh.
@@ -1945,29 +2186,19 @@ std::vector<ExPolygons> PrintObject::slice_volumes(const std::vector<float> &z,
 std::vector<ExPolygons> PrintObject::slice_volume(const std::vector<float> &z, const ModelVolume &volume) const
 {
     std::vector<ExPolygons> layers;
-    if (! z.empty()) {
-	    // Compose mesh.
-	    //FIXME better to split the mesh into separate shells, perform slicing over each shell separately and then to use a Boolean operation to merge them.
-	    TriangleMesh mesh(volume.mesh());
-	    mesh.transform(volume.get_matrix(), true);
-		if (mesh.repaired) {
-			//FIXME The admesh repair function may break the face connectivity, rather refresh it here as the slicing code relies on it.
-			stl_check_facets_exact(&mesh.stl);
-		}
-	    if (mesh.stl.stats.number_of_facets > 0) {
-	        mesh.transform(m_trafo, true);
-	        // apply XY shift
-	        mesh.translate(- unscale<float>(m_copies_shift(0)), - unscale<float>(m_copies_shift(1)), 0);
-	        // perform actual slicing
-	        TriangleMeshSlicer mslicer;
-	        const Print *print = this->print();
-	        auto callback = TriangleMeshSlicer::throw_on_cancel_callback_type([print](){print->throw_if_canceled();});
-	        // TriangleMeshSlicer needs the shared vertices.
-	        mesh.require_shared_vertices();
-	        mslicer.init(&mesh, callback);
-	        mslicer.slice(z, float(m_config.slice_closing_radius.value), &layers, callback);
-	        m_print->throw_if_canceled();
-	    }
+    if (! z.empty() && ! volume.mesh().empty()) {
+        // The mesh is not copied, it is transformed by the slicer on the fly. The slicing topology of the mesh
+        // is cached by the Print, so that re-slicing after a rotation or scaling does not rebuild it.
+        Print::SlicingTopology topology = m_print->slicing_topology(volume.get_mesh_shared_ptr());
+        // Volume transformation, object transformation, then the XY shift.
+        Transform3d trafo = Eigen::Translation3d(- unscale<double>(m_copies_shift(0)), - unscale<double>(m_copies_shift(1)), 0.) * m_trafo * volume.get_matrix();
+        // perform actual slicing
+        TriangleMeshSlicer mslicer;
+        const Print *print = this->print();
+        auto callback = TriangleMeshSlicer::throw_on_cancel_callback_type([print](){print->throw_if_canceled();});
+        mslicer.init(topology.mesh.get(), trafo, callback, topology.facets_edges);
+        mslicer.slice(z, float(m_config.slice_closing_radius.value), &layers, callback);
+        m_print->throw_if_canceled();
 	}
     return layers;
 }
@@ -2007,13 +2238,13 @@ std::vector<ExPolygons> PrintObject::slice_volume(const std::vector<float> &z, c
 	return out;
 }
 
-std::string PrintObject::_fix_slicing_errors()
+std::string PrintObject::_fix_slicing_errors(std::vector<size_t> &layers)
 {
-    // Collect layers with slicing errors.
+    // Collect the sliced layers with slicing errors, the reused layers were fixed already.
     // These layers will be fixed in parallel.
     std::vector<size_t> buggy_layers;
-    buggy_layers.reserve(m_layers.size());
-    for (size_t idx_layer = 0; idx_layer < m_layers.size(); ++ idx_layer)
+    buggy_layers.reserve(layers.size());
+    for (size_t idx_layer : layers)
         if (m_layers[idx_layer]->slicing_errors)
             buggy_layers.push_back(idx_layer);
 
@@ -2077,12 +2308,25 @@ std::string PrintObject::_fix_slicing_errors()
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - fixing slicing errors in parallel - end";
 
     // remove empty layers from bottom
+    size_t num_removed = 0;
     while (! m_layers.empty() && m_layers.front()->slices.expolygons.empty()) {
         delete m_layers.front();
         m_layers.erase(m_layers.begin());
         m_layers.front()->lower_layer = nullptr;
         for (size_t i = 0; i < m_layers.size(); ++ i)
             m_layers[i]->set_id(m_layers[i]->id() - 1);
+        ++ num_removed;
+    }
+    if (num_removed > 0) {
+        // The layer IDs changed, the perimeters and infill of all layers are to be generated again.
+        m_reusable_slices.clear();
+        m_reusable_perimeters.clear();
+        m_reusable_infill.clear();
+        size_t j = 0;
+        for (size_t idx_layer : layers)
+            if (idx_layer >= num_removed)
+                layers[j ++] = idx_layer - num_removed;
+        layers.erase(layers.begin() + j, layers.end());
     }
 
     return buggy_layers.empty() ? "" :
@@ -2093,18 +2337,20 @@ std::string PrintObject::_fix_slicing_errors()
 // Simplify the sliced model, if "resolution" configuration parameter > 0.
 // The simplification is problematic, because it simplifies the slices independent from each other,
 // which makes the simplified discretization visible on the object surface.
-void PrintObject::_simplify_slices(double distance)
+// The reused layers were simplified already.
+void PrintObject::_simplify_slices(double distance, const std::vector<size_t> &layers)
 {
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - siplifying slices in parallel - begin";
     tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
-        [this, distance](const tbb::blocked_range<size_t>& range) {
-            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+        tbb::blocked_range<size_t>(0, layers.size()),
+        [this, distance, &layers](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i) {
                 m_print->throw_if_canceled();
-                Layer *layer = m_layers[layer_idx];
+                Layer *layer = m_layers[layers[i]];
                 for (size_t region_idx = 0; region_idx < layer->m_regions.size(); ++ region_idx)
                     layer->m_regions[region_idx]->slices.simplify(distance);
                 layer->slices.simplify(distance);
+                layer->invalidate_slices_cache();
             }
         });
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - siplifying slices in parallel - end";
@@ -2303,179 +2549,250 @@ void PrintObject::clip_fill_surfaces()
 void PrintObject::discover_horizontal_shells()
 {
     BOOST_LOG_TRIVIAL(trace) << "discover_horizontal_shells()";
-    
-    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
-        for (size_t i = 0; i < m_layers.size(); ++ i) {
-            m_print->throw_if_canceled();
-            LayerRegion             *layerm = m_layers[i]->regions()[region_id];
-            const PrintRegionConfig &region_config = layerm->region()->config();
-            if (region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
-                (i % region_config.solid_infill_every_layers) == 0) {
-                // Insert a solid internal layer. Mark stInternal surfaces as stInternalSolid or stInternalBridge.
-                SurfaceType type = (region_config.fill_density == 100) ? stInternalSolid : stInternalBridge;
-                for (Surface &surface : layerm->fill_surfaces.surfaces)
-                    if (surface.surface_type == stInternal)
-                        surface.surface_type = type;
-            }
 
-            // If ensure_vertical_shell_thickness, then the rest has already been performed by discover_vertical_shells().
-            if (region_config.ensure_vertical_shell_thickness.value)
+    // Processing of a single layer of a single region. It modifies the fill_surfaces of this layer
+    // and of the layers below a top surface / above a bottom surface up to the number of solid layers.
+    auto discover_layer = [this](size_t region_id, size_t i) {
+        m_print->throw_if_canceled();
+        LayerRegion             *layerm = m_layers[i]->regions()[region_id];
+        const PrintRegionConfig &region_config = layerm->region()->config();
+        if (region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
+            (i % region_config.solid_infill_every_layers) == 0) {
+            // Insert a solid internal layer. Mark stInternal surfaces as stInternalSolid or stInternalBridge.
+            SurfaceType type = (region_config.fill_density == 100) ? stInternalSolid : stInternalBridge;
+            for (Surface &surface : layerm->fill_surfaces.surfaces)
+                if (surface.surface_type == stInternal)
+                    surface.surface_type = type;
+        }
+
+        // If ensure_vertical_shell_thickness, then the rest has already been performed by discover_vertical_shells().
+        if (region_config.ensure_vertical_shell_thickness.value)
+            return;
+        
+        for (size_t idx_surface_type = 0; idx_surface_type < 3; ++ idx_surface_type) {
+            m_print->throw_if_canceled();
+            SurfaceType type = (idx_surface_type == 0) ? stTop : (idx_surface_type == 1) ? stBottom : stBottomBridge;
+            // Find slices of current type for current layer.
+            // Use slices instead of fill_surfaces, because they also include the perimeter area,
+            // which needs to be propagated in shells; we need to grow slices like we did for
+            // fill_surfaces though. Using both ungrown slices and grown fill_surfaces will
+            // not work in some situations, as there won't be any grown region in the perimeter 
+            // area (this was seen in a model where the top layer had one extra perimeter, thus
+            // its fill_surfaces were thinner than the lower layer's infill), however it's the best
+            // solution so far. Growing the external slices by EXTERNAL_INFILL_MARGIN will put
+            // too much solid infill inside nearly-vertical slopes.
+
+            // Surfaces including the area of perimeters. Everything, that is visible from the top / bottom
+            // (not covered by a layer above / below).
+            // This does not contain the areas covered by perimeters!
+            Polygons solid;
+            for (const Surface &surface : layerm->slices.surfaces)
+                if (surface.surface_type == type)
+                    polygons_append(solid, to_polygons(surface.expolygon));
+            // Infill areas (slices without the perimeters).
+            for (const Surface &surface : layerm->fill_surfaces.surfaces)
+                if (surface.surface_type == type)
+                    polygons_append(solid, to_polygons(surface.expolygon));
+            if (solid.empty())
                 continue;
+//                Slic3r::debugf "Layer %d has %s surfaces\n", $i, ($type == S_TYPE_TOP) ? 'top' : 'bottom';
             
-            for (size_t idx_surface_type = 0; idx_surface_type < 3; ++ idx_surface_type) {
-                m_print->throw_if_canceled();
-                SurfaceType type = (idx_surface_type == 0) ? stTop : (idx_surface_type == 1) ? stBottom : stBottomBridge;
-                // Find slices of current type for current layer.
-                // Use slices instead of fill_surfaces, because they also include the perimeter area,
-                // which needs to be propagated in shells; we need to grow slices like we did for
-                // fill_surfaces though. Using both ungrown slices and grown fill_surfaces will
-                // not work in some situations, as there won't be any grown region in the perimeter 
-                // area (this was seen in a model where the top layer had one extra perimeter, thus
-                // its fill_surfaces were thinner than the lower layer's infill), however it's the best
-                // solution so far. Growing the external slices by EXTERNAL_INFILL_MARGIN will put
-                // too much solid infill inside nearly-vertical slopes.
-
-                // Surfaces including the area of perimeters. Everything, that is visible from the top / bottom
-                // (not covered by a layer above / below).
-                // This does not contain the areas covered by perimeters!
-                Polygons solid;
-                for (const Surface &surface : layerm->slices.surfaces)
-                    if (surface.surface_type == type)
-                        polygons_append(solid, to_polygons(surface.expolygon));
-                // Infill areas (slices without the perimeters).
-                for (const Surface &surface : layerm->fill_surfaces.surfaces)
-                    if (surface.surface_type == type)
-                        polygons_append(solid, to_polygons(surface.expolygon));
-                if (solid.empty())
+            size_t solid_layers = (type == stTop) ? region_config.top_solid_layers.value : region_config.bottom_solid_layers.value;                
+            for (int n = (type == stTop) ? i-1 : i+1; std::abs(n - (int)i) < solid_layers; (type == stTop) ? -- n : ++ n) {
+                if (n < 0 || n >= int(m_layers.size()))
                     continue;
-//                Slic3r::debugf "Layer %d has %s surfaces\n", $i, ($type == S_TYPE_TOP) ? 'top' : 'bottom';
+//                    Slic3r::debugf "  looking for neighbors on layer %d...\n", $n;                  
+                // Reference to the lower layer of a TOP surface, or an upper layer of a BOTTOM surface.
+                LayerRegion *neighbor_layerm = m_layers[n]->regions()[region_id];
                 
-                size_t solid_layers = (type == stTop) ? region_config.top_solid_layers.value : region_config.bottom_solid_layers.value;                
-                for (int n = (type == stTop) ? i-1 : i+1; std::abs(n - (int)i) < solid_layers; (type == stTop) ? -- n : ++ n) {
-                    if (n < 0 || n >= int(m_layers.size()))
+                // find intersection between neighbor and current layer's surfaces
+                // intersections have contours and holes
+                // we update $solid so that we limit the next neighbor layer to the areas that were
+                // found on this one - in other words, solid shells on one layer (for a given external surface)
+                // are always a subset of the shells found on the previous shell layer
+                // this approach allows for DWIM in hollow sloping vases, where we want bottom
+                // shells to be generated in the base but not in the walls (where there are many
+                // narrow bottom surfaces): reassigning $solid will consider the 'shadow' of the 
+                // upper perimeter as an obstacle and shell will not be propagated to more upper layers
+                //FIXME How does it work for S_TYPE_INTERNALBRIDGE? This is set for sparse infill. Likely this does not work.
+                Polygons new_internal_solid;
+                {
+                    Polygons internal;
+                    for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
+                        if (surface.surface_type == stInternal || surface.surface_type == stInternalSolid)
+                            polygons_append(internal, to_polygons(surface.expolygon));
+                    new_internal_solid = intersection(solid, internal, true);
+                }
+                if (new_internal_solid.empty()) {
+                    // No internal solid needed on this layer. In order to decide whether to continue
+                    // searching on the next neighbor (thus enforcing the configured number of solid
+                    // layers, use different strategies according to configured infill density:
+                    if (region_config.fill_density.value == 0) {
+                        // If user expects the object to be void (for example a hollow sloping vase),
+                        // don't continue the search. In this case, we only generate the external solid
+                        // shell if the object would otherwise show a hole (gap between perimeters of 
+                        // the two layers), and internal solid shells are a subset of the shells found 
+                        // on each previous layer.
+                        goto EXTERNAL;
+                    } else {
+                        // If we have internal infill, we can generate internal solid shells freely.
                         continue;
-//                    Slic3r::debugf "  looking for neighbors on layer %d...\n", $n;                  
-                    // Reference to the lower layer of a TOP surface, or an upper layer of a BOTTOM surface.
-                    LayerRegion *neighbor_layerm = m_layers[n]->regions()[region_id];
-                    
-                    // find intersection between neighbor and current layer's surfaces
-                    // intersections have contours and holes
-                    // we update $solid so that we limit the next neighbor layer to the areas that were
-                    // found on this one - in other words, solid shells on one layer (for a given external surface)
-                    // are always a subset of the shells found on the previous shell layer
-                    // this approach allows for DWIM in hollow sloping vases, where we want bottom
-                    // shells to be generated in the base but not in the walls (where there are many
-                    // narrow bottom surfaces): reassigning $solid will consider the 'shadow' of the 
-                    // upper perimeter as an obstacle and shell will not be propagated to more upper layers
-                    //FIXME How does it work for S_TYPE_INTERNALBRIDGE? This is set for sparse infill. Likely this does not work.
-                    Polygons new_internal_solid;
-                    {
+                    }
+                }
+                
+                if (region_config.fill_density.value == 0) {
+                    // if we're printing a hollow object we discard any solid shell thinner
+                    // than a perimeter width, since it's probably just crossing a sloping wall
+                    // and it's not wanted in a hollow print even if it would make sense when
+                    // obeying the solid shell count option strictly (DWIM!)
+                    float margin = float(neighbor_layerm->flow(frExternalPerimeter).scaled_width());
+                    Polygons too_narrow = diff(
+                        new_internal_solid, 
+                        offset2(new_internal_solid, -margin, +margin, jtMiter, 5), 
+                        true);
+                    // Trim the regularized region by the original region.
+                    if (! too_narrow.empty())
+                        new_internal_solid = solid = diff(new_internal_solid, too_narrow);
+                }
+
+                // make sure the new internal solid is wide enough, as it might get collapsed
+                // when spacing is added in Fill.pm
+                {
+                    //FIXME Vojtech: Disable this and you will be sorry.
+                    // https://github.com/prusa3d/PrusaSlicer/issues/26 bottom
+                    float margin = 3.f * layerm->flow(frSolidInfill).scaled_width(); // require at least this size
+                    // we use a higher miterLimit here to handle areas with acute angles
+                    // in those cases, the default miterLimit would cut the corner and we'd
+                    // get a triangle in $too_narrow; if we grow it below then the shell
+                    // would have a different shape from the external surface and we'd still
+                    // have the same angle, so the next shell would be grown even more and so on.
+                    Polygons too_narrow = diff(
+                        new_internal_solid,
+                        offset2(new_internal_solid, -margin, +margin, ClipperLib::jtMiter, 5),
+                        true);
+                    if (! too_narrow.empty()) {
+                        // grow the collapsing parts and add the extra area to  the neighbor layer 
+                        // as well as to our original surfaces so that we support this 
+                        // additional area in the next shell too
+                        // make sure our grown surfaces don't exceed the fill area
                         Polygons internal;
                         for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
-                            if (surface.surface_type == stInternal || surface.surface_type == stInternalSolid)
+                            if (surface.is_internal() && !surface.is_bridge())
                                 polygons_append(internal, to_polygons(surface.expolygon));
-                        new_internal_solid = intersection(solid, internal, true);
-                    }
-                    if (new_internal_solid.empty()) {
-                        // No internal solid needed on this layer. In order to decide whether to continue
-                        // searching on the next neighbor (thus enforcing the configured number of solid
-                        // layers, use different strategies according to configured infill density:
-                        if (region_config.fill_density.value == 0) {
-                            // If user expects the object to be void (for example a hollow sloping vase),
-                            // don't continue the search. In this case, we only generate the external solid
-                            // shell if the object would otherwise show a hole (gap between perimeters of 
-                            // the two layers), and internal solid shells are a subset of the shells found 
-                            // on each previous layer.
-                            goto EXTERNAL;
-                        } else {
-                            // If we have internal infill, we can generate internal solid shells freely.
-                            continue;
-                        }
-                    }
-                    
-                    if (region_config.fill_density.value == 0) {
-                        // if we're printing a hollow object we discard any solid shell thinner
-                        // than a perimeter width, since it's probably just crossing a sloping wall
-                        // and it's not wanted in a hollow print even if it would make sense when
-                        // obeying the solid shell count option strictly (DWIM!)
-                        float margin = float(neighbor_layerm->flow(frExternalPerimeter).scaled_width());
-                        Polygons too_narrow = diff(
-                            new_internal_solid, 
-                            offset2(new_internal_solid, -margin, +margin, jtMiter, 5), 
-                            true);
-                        // Trim the regularized region by the original region.
-                        if (! too_narrow.empty())
-                            new_internal_solid = solid = diff(new_internal_solid, too_narrow);
+                        polygons_append(new_internal_solid, 
+                            intersection(
+                                offset(too_narrow, +margin),
+                                // Discard bridges as they are grown for anchoring and we can't
+                                // remove such anchors. (This may happen when a bridge is being 
+                                // anchored onto a wall where little space remains after the bridge
+                                // is grown, and that little space is an internal solid shell so 
+                                // it triggers this too_narrow logic.)
+                                internal));
+                        solid = new_internal_solid;
                     }
+                }
+                
+                // internal-solid are the union of the existing internal-solid surfaces
+                // and new ones
+                SurfaceCollection backup = std::move(neighbor_layerm->fill_surfaces);
+                polygons_append(new_internal_solid, to_polygons(backup.filter_by_type(stInternalSolid)));
+                ExPolygons internal_solid = union_ex(new_internal_solid, false);
+                // assign new internal-solid surfaces to layer
+                neighbor_layerm->fill_surfaces.set(internal_solid, stInternalSolid);
+                // subtract intersections from layer surfaces to get resulting internal surfaces
+                Polygons polygons_internal = to_polygons(std::move(internal_solid));
+                ExPolygons internal = diff_ex(
+                    to_polygons(backup.filter_by_type(stInternal)),
+                    polygons_internal,
+                    true);
+                // assign resulting internal surfaces to layer
+                neighbor_layerm->fill_surfaces.append(internal, stInternal);
+                polygons_append(polygons_internal, to_polygons(std::move(internal)));
+                // assign top and bottom surfaces to layer
+                SurfaceType surface_types_solid[] = { stTop, stBottom, stBottomBridge };
+                backup.keep_types(surface_types_solid, 3);
+                std::vector<SurfacesPtr> top_bottom_groups;
+                backup.group(&top_bottom_groups);
+                for (SurfacesPtr &group : top_bottom_groups)
+                    neighbor_layerm->fill_surfaces.append(
+                        diff_ex(to_polygons(group), polygons_internal),
+                        // Use an existing surface as a template, it carries the bridge angle etc.
+                        *group.front());
+            }
+	EXTERNAL:;
+        } // foreach type (stTop, stBottom, stBottomBridge)
+    };
 
-                    // make sure the new internal solid is wide enough, as it might get collapsed
-                    // when spacing is added in Fill.pm
-                    {
-                        //FIXME Vojtech: Disable this and you will be sorry.
-                        // https://github.com/prusa3d/PrusaSlicer/issues/26 bottom
-                        float margin = 3.f * layerm->flow(frSolidInfill).scaled_width(); // require at least this size
-                        // we use a higher miterLimit here to handle areas with acute angles
-                        // in those cases, the default miterLimit would cut the corner and we'd
-                        // get a triangle in $too_narrow; if we grow it below then the shell
-                        // would have a different shape from the external surface and we'd still
-                        // have the same angle, so the next shell would be grown even more and so on.
-                        Polygons too_narrow = diff(
-                            new_internal_solid,
-                            offset2(new_internal_solid, -margin, +margin, ClipperLib::jtMiter, 5),
-                            true);
-                        if (! too_narrow.empty()) {
-                            // grow the collapsing parts and add the extra area to  the neighbor layer 
-                            // as well as to our original surfaces so that we support this 
-                            // additional area in the next shell too
-                            // make sure our grown surfaces don't exceed the fill area
-                            Polygons internal;
-                            for (const Surface &surface : neighbor_layerm->fill_surfaces.surfaces)
-                                if (surface.is_internal() && !surface.is_bridge())
-                                    polygons_append(internal, to_polygons(surface.expolygon));
-                            polygons_append(new_internal_solid, 
-                                intersection(
-                                    offset(too_narrow, +margin),
-                                    // Discard bridges as they are grown for anchoring and we can't
-                                    // remove such anchors. (This may happen when a bridge is being 
-                                    // anchored onto a wall where little space remains after the bridge
-                                    // is grown, and that little space is an internal solid shell so 
-                                    // it triggers this too_narrow logic.)
-                                    internal));
-                            solid = new_internal_solid;
-                        }
+    // The layers are not processed one after the other. Processing of a layer touches the window of layers
+    // affected by its top / bottom surfaces only, therefore the layers are grouped into clusters with overlapping
+    // windows. Clusters do not share any layer, so they are processed in parallel, while the layers
+    // of a cluster are processed in their original order. The result is the same as if all the layers were
+    // processed one after the other.
+    struct LayerWindow {
+        size_t layer_id;
+        // Span of layers touched by processing of layer_id, inclusive.
+        size_t first;
+        size_t last;
+    };
+    // Layers of a single region to be processed in order.
+    struct Cluster {
+        size_t              region_id;
+        std::vector<size_t> layers;
+    };
+    std::vector<Cluster> clusters;
+    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
+        std::vector<LayerWindow> windows;
+        for (size_t i = 0; i < m_layers.size(); ++ i) {
+            const LayerRegion       *layerm = m_layers[i]->regions()[region_id];
+            const PrintRegionConfig &region_config = layerm->region()->config();
+            bool solid_infill_every = region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
+                (i % region_config.solid_infill_every_layers) == 0;
+            // The top / bottom surfaces may only shrink while processing the layers, therefore testing
+            // their presence before processing is conservative.
+            bool has_top = false, has_bottom = false;
+            if (! region_config.ensure_vertical_shell_thickness.value) {
+                for (const SurfaceCollection *surfaces : { &layerm->slices, &layerm->fill_surfaces })
+                    for (const Surface &surface : surfaces->surfaces) {
+                        has_top    |= surface.surface_type == stTop;
+                        has_bottom |= surface.surface_type == stBottom || surface.surface_type == stBottomBridge;
                     }
-                    
-                    // internal-solid are the union of the existing internal-solid surfaces
-                    // and new ones
-                    SurfaceCollection backup = std::move(neighbor_layerm->fill_surfaces);
-                    polygons_append(new_internal_solid, to_polygons(backup.filter_by_type(stInternalSolid)));
-                    ExPolygons internal_solid = union_ex(new_internal_solid, false);
-                    // assign new internal-solid surfaces to layer
-                    neighbor_layerm->fill_surfaces.set(internal_solid, stInternalSolid);
-                    // subtract intersections from layer surfaces to get resulting internal surfaces
-                    Polygons polygons_internal = to_polygons(std::move(internal_solid));
-                    ExPolygons internal = diff_ex(
-                        to_polygons(backup.filter_by_type(stInternal)),
-                        polygons_internal,
-                        true);
-                    // assign resulting internal surfaces to layer
-                    neighbor_layerm->fill_surfaces.append(internal, stInternal);
-                    polygons_append(polygons_internal, to_polygons(std::move(internal)));
-                    // assign top and bottom surfaces to layer
-                    SurfaceType surface_types_solid[] = { stTop, stBottom, stBottomBridge };
-                    backup.keep_types(surface_types_solid, 3);
-                    std::vector<SurfacesPtr> top_bottom_groups;
-                    backup.group(&top_bottom_groups);
-                    for (SurfacesPtr &group : top_bottom_groups)
-                        neighbor_layerm->fill_surfaces.append(
-                            diff_ex(to_polygons(group), polygons_internal),
-                            // Use an existing surface as a template, it carries the bridge angle etc.
-                            *group.front());
-                }
-		EXTERNAL:;
-            } // foreach type (stTop, stBottom, stBottomBridge)
-        } // for each layer
-    } // for each region
+            }
+            if (! solid_infill_every && ! has_top && ! has_bottom)
+                continue;
+            size_t top_solid_layers    = (size_t)std::max(1, region_config.top_solid_layers.value);
+            size_t bottom_solid_layers = (size_t)std::max(1, region_config.bottom_solid_layers.value);
+            windows.push_back({ i,
+                has_top    ? i - std::min(i, top_solid_layers - 1) : i,
+                has_bottom ? std::min(m_layers.size() - 1, i + bottom_solid_layers - 1) : i });
+        }
+        // Merge the overlapping windows into clusters.
+        std::vector<LayerWindow> sorted = windows;
+        std::stable_sort(sorted.begin(), sorted.end(), [](const LayerWindow &w1, const LayerWindow &w2) { return w1.first < w2.first; });
+        std::vector<size_t> cluster_of_layer(m_layers.size(), size_t(-1));
+        size_t cluster_last = 0;
+        for (size_t i = 0; i < sorted.size(); ++ i) {
+            if (i == 0 || sorted[i].first > cluster_last) {
+                clusters.push_back({ region_id, {} });
+                cluster_last = sorted[i].last;
+            } else
+                cluster_last = std::max(cluster_last, sorted[i].last);
+            cluster_of_layer[sorted[i].layer_id] = clusters.size() - 1;
+        }
+        // Keep the original order of layers inside a cluster.
+        for (const LayerWindow &window : windows)
+            clusters[cluster_of_layer[window.layer_id]].layers.emplace_back(window.layer_id);
+    }
+
+    BOOST_LOG_TRIVIAL(debug) << "discover_horizontal_shells() in parallel - " << clusters.size() << " clusters - start";
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, clusters.size(), 1),
+        [&clusters, &discover_layer](const tbb::blocked_range<size_t>& range) {
+            for (size_t cluster_id = range.begin(); cluster_id < range.end(); ++ cluster_id)
+                for (size_t layer_id : clusters[cluster_id].layers)
+                    discover_layer(clusters[cluster_id].region_id, layer_id);
+        });
+    m_print->throw_if_canceled();
+    BOOST_LOG_TRIVIAL(debug) << "discover_horizontal_shells() in parallel - end";
 
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
@@ -2531,72 +2848,83 @@ void PrintObject::combine_infill()
             combine[m_layers.size() - 1] = num_layers;
         }
         
-        // loop through layers to which we have assigned layers to combine
-        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
-            m_print->throw_if_canceled();
-            size_t num_layers = combine[layer_idx];
-			if (num_layers <= 1)
-                continue;
-            // Get all the LayerRegion objects to be combined.
-            std::vector<LayerRegion*> layerms;
-            layerms.reserve(num_layers);
-			for (size_t i = layer_idx + 1 - num_layers; i <= layer_idx; ++ i)
-                layerms.emplace_back(m_layers[i]->regions()[region_id]);
-            // We need to perform a multi-layer intersection, so let's split it in pairs.
-            // Initialize the intersection with the candidates of the lowest layer.
-            ExPolygons intersection = to_expolygons(layerms.front()->fill_surfaces.filter_by_type(stInternal));
-            // Start looping from the second layer and intersect the current intersection with it.
-            for (size_t i = 1; i < layerms.size(); ++ i)
-                intersection = intersection_ex(
-                    to_polygons(intersection),
-                    to_polygons(layerms[i]->fill_surfaces.filter_by_type(stInternal)),
-                    false);
-            double area_threshold = layerms.front()->infill_area_threshold();
-            if (! intersection.empty() && area_threshold > 0.)
-                intersection.erase(std::remove_if(intersection.begin(), intersection.end(), 
-                    [area_threshold](const ExPolygon &expoly) { return expoly.area() <= area_threshold; }), 
-                    intersection.end());
-            if (intersection.empty())
-                continue;
-//            Slic3r::debugf "  combining %d %s regions from layers %d-%d\n",
-//                scalar(@$intersection),
-//                ($type == S_TYPE_INTERNAL ? 'internal' : 'internal-solid'),
-//                $layer_idx-($every-1), $layer_idx;
-            // intersection now contains the regions that can be combined across the full amount of layers,
-            // so let's remove those areas from all layers.
-            Polygons intersection_with_clearance;
-            intersection_with_clearance.reserve(intersection.size());
-            float clearance_offset = 
-                0.5f * layerms.back()->flow(frPerimeter).scaled_width() +
-             // Because fill areas for rectilinear and honeycomb are grown 
-             // later to overlap perimeters, we need to counteract that too.
-                ((region->config().fill_pattern == ipRectilinear   ||
-                  region->config().fill_pattern == ipGrid          ||
-                  region->config().fill_pattern == ipLine          ||
-                  region->config().fill_pattern == ipHoneycomb) ? 1.5f : 0.5f) * 
-                    layerms.back()->flow(frSolidInfill).scaled_width();
-            for (ExPolygon &expoly : intersection)
-                polygons_append(intersection_with_clearance, offset(expoly, clearance_offset));
-            for (LayerRegion *layerm : layerms) {
-                Polygons internal = to_polygons(layerm->fill_surfaces.filter_by_type(stInternal));
-                layerm->fill_surfaces.remove_type(stInternal);
-                layerm->fill_surfaces.append(diff_ex(internal, intersection_with_clearance, false), stInternal);
-                if (layerm == layerms.back()) {
-                    // Apply surfaces back with adjusted depth to the uppermost layer.
-                    Surface templ(stInternal, ExPolygon());
-                    templ.thickness = 0.;
-                    for (LayerRegion *layerm2 : layerms)
-                        templ.thickness += layerm2->layer()->height;
-                    templ.thickness_layers = (unsigned short)layerms.size();
-                    layerm->fill_surfaces.append(intersection, templ);
-                } else {
-                    // Save void surfaces.
-                    layerm->fill_surfaces.append(
-                        intersection_ex(internal, intersection_with_clearance, false),
-                        stInternalVoid);
+        // Upper layers of the groups of layers to be combined. The groups do not overlap, therefore they are processed in parallel.
+        std::vector<size_t> combine_upper_layers;
+        for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx)
+            if (combine[layer_idx] > 1)
+                combine_upper_layers.emplace_back(layer_idx);
+
+        BOOST_LOG_TRIVIAL(debug) << "Combine infill - region " << region_id << " in parallel - start";
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, combine_upper_layers.size()),
+            [this, region, region_id, &combine, &combine_upper_layers](const tbb::blocked_range<size_t>& range) {
+                for (size_t group_idx = range.begin(); group_idx < range.end(); ++ group_idx) {
+                    m_print->throw_if_canceled();
+                    size_t layer_idx  = combine_upper_layers[group_idx];
+                    size_t num_layers = combine[layer_idx];
+                    // Get all the LayerRegion objects to be combined.
+                    std::vector<LayerRegion*> layerms;
+                    layerms.reserve(num_layers);
+                    for (size_t i = layer_idx + 1 - num_layers; i <= layer_idx; ++ i)
+                        layerms.emplace_back(m_layers[i]->regions()[region_id]);
+                    // We need to perform a multi-layer intersection, so let's split it in pairs.
+                    // Initialize the intersection with the candidates of the lowest layer.
+                    ExPolygons intersection = to_expolygons(layerms.front()->fill_surfaces.filter_by_type(stInternal));
+                    // Start looping from the second layer and intersect the current intersection with it.
+                    for (size_t i = 1; i < layerms.size(); ++ i)
+                        intersection = intersection_ex(
+                            to_polygons(intersection),
+                            to_polygons(layerms[i]->fill_surfaces.filter_by_type(stInternal)),
+                            false);
+                    double area_threshold = layerms.front()->infill_area_threshold();
+                    if (! intersection.empty() && area_threshold > 0.)
+                        intersection.erase(std::remove_if(intersection.begin(), intersection.end(), 
+                            [area_threshold](const ExPolygon &expoly) { return expoly.area() <= area_threshold; }), 
+                            intersection.end());
+                    if (intersection.empty())
+                        continue;
+//                    Slic3r::debugf "  combining %d %s regions from layers %d-%d\n",
+//                        scalar(@$intersection),
+//                        ($type == S_TYPE_INTERNAL ? 'internal' : 'internal-solid'),
+//                        $layer_idx-($every-1), $layer_idx;
+                    // intersection now contains the regions that can be combined across the full amount of layers,
+                    // so let's remove those areas from all layers.
+                    Polygons intersection_with_clearance;
+                    intersection_with_clearance.reserve(intersection.size());
+                    float clearance_offset = 
+                        0.5f * layerms.back()->flow(frPerimeter).scaled_width() +
+                     // Because fill areas for rectilinear and honeycomb are grown 
+                     // later to overlap perimeters, we need to counteract that too.
+                        ((region->config().fill_pattern == ipRectilinear   ||
+                          region->config().fill_pattern == ipGrid          ||
+                          region->config().fill_pattern == ipLine          ||
+                          region->config().fill_pattern == ipHoneycomb) ? 1.5f : 0.5f) * 
+                            layerms.back()->flow(frSolidInfill).scaled_width();
+                    for (ExPolygon &expoly : intersection)
+                        polygons_append(intersection_with_clearance, offset(expoly, clearance_offset));
+                    for (LayerRegion *layerm : layerms) {
+                        Polygons internal = to_polygons(layerm->fill_surfaces.filter_by_type(stInternal));
+                        layerm->fill_surfaces.remove_type(stInternal);
+                        layerm->fill_surfaces.append(diff_ex(internal, intersection_with_clearance, false), stInternal);
+                        if (layerm == layerms.back()) {
+                            // Apply surfaces back with adjusted depth to the uppermost layer.
+                            Surface templ(stInternal, ExPolygon());
+                            templ.thickness = 0.;
+                            for (LayerRegion *layerm2 : layerms)
+                                templ.thickness += layerm2->layer()->height;
+                            templ.thickness_layers = (unsigned short)layerms.size();
+                            layerm->fill_surfaces.append(intersection, templ);
+                        } else {
+                            // Save void surfaces.
+                            layerm->fill_surfaces.append(
+                                intersection_ex(internal, intersection_with_clearance, false),
+                                stInternalVoid);
+                        }
+                    }
                 }
-            }
-        }
+            });
+        m_print->throw_if_canceled();
+        BOOST_LOG_TRIVIAL(debug) << "Combine infill - region " << region_id << " in parallel - end";
     }
 }
 
@@ -7,6 +7,8 @@
 #include "Tesselate.hpp"
 #include "MTUtils.hpp"
 
+#include <tbb/parallel_for.h>
+
 // For debugging:
 // #include <fstream>
 // #include <libnest2d/tools/benchmark.h>
@@ -494,22 +496,37 @@ Contour3D round_edges(const ExPolygon& base_plate,
     coord_t s = dir? 1 : -1;
     degrees = std::fmod(degrees, 180);
 
+    // The offsetted versions of the base plate for the individual rounding
+    // steps are independent of each other, so they are calculated in parallel
+    // in advance. Only the walls connecting them are generated sequentially.
+    auto offsets = [&base_plate, s, thr](const std::vector<double> &dists) {
+        std::vector<ExPolygon> ret(dists.size(), base_plate);
+        tbb::parallel_for(size_t(0), dists.size(), [&ret, &dists, s, thr](size_t i) {
+            thr();
+            offset(ret[i], s * scaled(dists[i]));
+        });
+        return ret;
+    };
+
     // we use sin for x distance because we interpret the angle starting from
     // PI/2
     int tos = degrees < 90?
             int(radius_mm*std::cos(degrees * PI / 180 - PI/2) / stepx) : steps;
 
+    std::vector<double> dists(size_t(std::max(tos, 0)));
+    for(int i = 1; i <= tos; ++i) dists[size_t(i - 1)] = i*stepx;
+    std::vector<ExPolygon> obs = offsets(dists);
+
     for(int i = 1; i <= tos; ++i) {
         thr();
 
-        ob = base_plate;
+        ob = std::move(obs[size_t(i - 1)]);
 
         double r2 = radius_mm * radius_mm;
         double xx = i*stepx;
         double x2 = xx*xx;
         double stepy = std::sqrt(r2 - x2);
 
-        offset(ob, s * scaled(xx));
         wh = ceilheight_mm - radius_mm + stepy;
 
         Contour3D pwalls;
@@ -525,15 +542,18 @@ Contour3D round_edges(const ExPolygon& base_plate,
         double tox = radius_mm - radius_mm*std::cos(degrees * PI / 180 - PI/2);
         int tos = int(tox / stepx);
 
+        dists.assign(size_t(std::max(tos, 0)), 0.);
+        for(int i = 1; i <= tos; ++i) dists[size_t(i - 1)] = radius_mm - i*stepx;
+        obs = offsets(dists);
+
         for(int i = 1; i <= tos; ++i) {
             thr();
-            ob = base_plate;
+            ob = std::move(obs[size_t(i - 1)]);
 
             double r2 = radius_mm * radius_mm;
             double xx = radius_mm - i*stepx;
             double x2 = xx*xx;
             double stepy = std::sqrt(r2 - x2);
-            offset(ob, s * scaled(xx));
             wh = ceilheight_mm - radius_mm - stepy;
 
             Contour3D pwalls;
@@ -667,35 +687,75 @@ Polygons concave_hull(const Polygons& polys, double maxd_mm, ThrowOnCancel thr)
     return punion;
 }
 
+// Simplifies the slices of each sampled level, in parallel.
+static std::vector<ExPolygons> simplify_levels(const std::vector<ExPolygons> &levels,
+                                               ThrowOnCancel                  thrfn)
+{
+    std::vector<ExPolygons> simplified(levels.size());
+    tbb::parallel_for(size_t(0), levels.size(),
+                      [&levels, &simplified, thrfn](size_t i) {
+        thrfn();
+        for(const ExPolygon& e : levels[i]) {
+            auto&& exss = e.simplify(scaled<double>(0.1));
+            for(ExPolygon& ep : exss) simplified[i].emplace_back(std::move(ep));
+        }
+    });
+    return simplified;
+}
+
+// Merges the simplified slices of the sampled levels into the silhouette.
+static void merge_levels(const std::vector<ExPolygons> &levels,
+                         ExPolygons &                   output,
+                         ThrowOnCancel                  thrfn)
+{
+    if (levels.empty()) return;
+
+    // Now we have to unify all slice levels which can be an expensive
+    // operation. The slices of the neighboring levels overlap almost
+    // completely, so unifying the levels pairwise is much cheaper than
+    // unifying all of them at once.
+    std::vector<ExPolygons> merged((levels.size() + 1) / 2);
+    tbb::parallel_for(size_t(0), merged.size(),
+                      [&levels, &merged, thrfn](size_t i) {
+        thrfn();
+        ExPolygons pair = levels[2 * i];
+        if (2 * i + 1 < levels.size())
+            pair.insert(pair.end(), levels[2 * i + 1].begin(), levels[2 * i + 1].end());
+        merged[i] = unify(pair);
+    });
+
+    while (merged.size() > 1) {
+        std::vector<ExPolygons> next((merged.size() + 1) / 2);
+        tbb::parallel_for(size_t(0), next.size(),
+                          [&merged, &next, thrfn](size_t i) {
+            thrfn();
+            ExPolygons &pair = merged[2 * i];
+            if (2 * i + 1 < merged.size())
+                for (ExPolygon &e : merged[2 * i + 1]) pair.emplace_back(std::move(e));
+            next[i] = unify(pair);
+        });
+        merged = std::move(next);
+    }
+
+    for(auto& o : merged.front()) {
+        auto&& smp = o.simplify(scaled<double>(0.1));
+        output.insert(output.end(), smp.begin(), smp.end());
+    }
+}
+
 void base_plate(const TriangleMesh &      mesh,
                 ExPolygons &              output,
                 const std::vector<float> &heights,
                 ThrowOnCancel             thrfn)
 {
     if (mesh.empty()) return;
-    //    m.require_shared_vertices(); // TriangleMeshSlicer needs this    
+    //    m.require_shared_vertices(); // TriangleMeshSlicer needs this
     TriangleMeshSlicer slicer(&mesh);
-    
+
     std::vector<ExPolygons> out; out.reserve(heights.size());
     slicer.slice(heights, 0.f, &out, thrfn);
-    
-    size_t count = 0; for(auto& o : out) count += o.size();
-    
-    // Now we have to unify all slice layers which can be an expensive operation
-    // so we will try to simplify the polygons
-    ExPolygons tmp; tmp.reserve(count);
-    for(ExPolygons& o : out)
-        for(ExPolygon& e : o) {
-            auto&& exss = e.simplify(scaled<double>(0.1));
-            for(ExPolygon& ep : exss) tmp.emplace_back(std::move(ep));
-        }
-    
-    ExPolygons utmp = unify(tmp);
-    
-    for(auto& o : utmp) {
-        auto&& smp = o.simplify(scaled<double>(0.1));
-        output.insert(output.end(), smp.begin(), smp.end());
-    }
+
+    merge_levels(simplify_levels(out, thrfn), output, thrfn);
 }
 
 void base_plate(const TriangleMesh &mesh,
@@ -707,13 +767,64 @@ void base_plate(const TriangleMesh &mesh,
     auto bb = mesh.bounding_box();
     float gnd = float(bb.min(Z));
     std::vector<float> heights = {float(bb.min(Z))};
-    
+
     for(float hi = gnd + layerh; hi <= gnd + h; hi += layerh)
         heights.emplace_back(hi);
-    
+
     base_plate(mesh, output, heights, thrfn);
 }
 
+BasePlateSampler::BasePlateSampler(const TriangleMesh &mesh,
+                                   double              ground_level,
+                                   double              layerheight) :
+    m_mesh(&mesh), m_ground_level(ground_level), m_layerheight(layerheight)
+{}
+
+BasePlateSampler::~BasePlateSampler() = default;
+
+void BasePlateSampler::base_plate(ExPolygons &  output,
+                                  double        zmin,
+                                  double        zmax,
+                                  ThrowOnCancel thrfn)
+{
+    if (m_mesh->empty()) return;
+
+    // Indices of the sampled levels, zmin inclusive, zmax exclusive.
+    long first = long(std::ceil((zmin - m_ground_level) / m_layerheight - EPSILON));
+    long last  = long(std::ceil((zmax - m_ground_level) / m_layerheight - EPSILON));
+    long kept_first = m_first;
+    long kept_last  = m_first + long(m_levels.size());
+
+    std::vector<ExPolygons> levels(size_t(std::max(last - first, 0l)));
+    std::vector<float>      heights;
+    std::vector<size_t>     missing;
+    for (long i = first; i < last; ++i)
+        if (i >= kept_first && i < kept_last)
+            levels[size_t(i - first)] = m_levels[size_t(i - kept_first)];
+        else {
+            heights.emplace_back(float(m_ground_level + i * m_layerheight));
+            missing.emplace_back(size_t(i - first));
+        }
+
+    if (!heights.empty()) {
+        // The mesh has to have its shared vertices, see TriangleMeshSlicer.
+        if (!m_slicer) m_slicer.reset(new TriangleMeshSlicer(m_mesh));
+
+        std::vector<ExPolygons> out; out.reserve(heights.size());
+        m_slicer->slice(heights, 0.f, &out, thrfn);
+        out = simplify_levels(out, thrfn);
+        for (size_t i = 0; i < missing.size(); ++i)
+            levels[missing[i]] = std::move(out[i]);
+    }
+
+    // Only the levels of the last call are kept, the next call (e.g. after a
+    // change of the wall height) will most likely sample an overlapping range.
+    m_first  = first;
+    m_levels = std::move(levels);
+
+    merge_levels(m_levels, output, thrfn);
+}
+
 Contour3D create_base_pool(const Polygons &ground_layer, 
                            const ExPolygons &obj_self_pad = {},
                            const PoolConfig& cfg = PoolConfig()) 
@@ -732,6 +843,11 @@ Contour3D create_base_pool(const Polygons &ground_layer,
     // trick will create a nice rounded pad shape.
     Polygons concavehs = concave_hull(ground_layer, mergedist, cfg.throw_on_cancel);
 
+    // Islands after an empty one are not part of the pad.
+    concavehs.erase(std::find_if(concavehs.begin(), concavehs.end(),
+                                 [](const Polygon &p) { return p.points.empty(); }),
+                    concavehs.end());
+
     const double thickness      = cfg.min_wall_thickness_mm;
     const double wingheight     = cfg.min_wall_height_mm;
     const double fullheight     = wingheight + thickness;
@@ -748,10 +864,13 @@ Contour3D create_base_pool(const Polygons &ground_layer,
 
     auto& thrcl = cfg.throw_on_cancel;
 
-    Contour3D pool;
+    // The islands of the footprint are independent of each other. Their
+    // geometries are generated in parallel and merged in the original order.
+    std::vector<Contour3D> islands(concavehs.size());
 
-    for(Polygon& concaveh : concavehs) {
-        if(concaveh.points.empty()) return pool;
+    tbb::parallel_for(size_t(0), concavehs.size(), [&](size_t island_idx) {
+        const Polygon &concaveh = concavehs[island_idx];
+        Contour3D &    pool     = islands[island_idx];
 
         // Here lies the trick that does the smoothing only with clipper offset
         // calls. The offset is configured to round edges. Inner edges will
@@ -899,7 +1018,10 @@ Contour3D create_base_pool(const Polygons &ground_layer,
         if(wingheight > 0)
             pool.merge(triangulate_expolygon_3d(inner_base, -wingheight));
 
-    }
+    });
+
+    Contour3D pool;
+    for (const Contour3D &island : islands) pool.merge(island);
     
     return pool;
 }
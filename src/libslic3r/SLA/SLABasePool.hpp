@@ -4,6 +4,7 @@
 #include <vector>
 #include <functional>
 #include <cmath>
+#include <memory>
 
 namespace Slic3r {
 
@@ -13,6 +14,7 @@ using ExPolygons = std::vector<ExPolygon>;
 using Polygons = std::vector<Polygon>;
 
 class TriangleMesh;
+class TriangleMeshSlicer;
 
 namespace sla {
 
@@ -30,6 +32,32 @@ void base_plate(const TriangleMesh& mesh,       // input mesh
                 const std::vector<float>&,      // Exact Z levels to sample
                 ThrowOnCancel thrfn = [](){});  // Will be called frequently
 
+/// Samples the silhouette of a mesh at the levels ground_level + i * layerheight.
+/// The levels do not depend on the pad configuration, so the levels shared by
+/// subsequent calls (e.g. after a change of the wall height) are not sliced
+/// again. The mesh has to outlive the sampler.
+class BasePlateSampler {
+public:
+    BasePlateSampler(const TriangleMesh& mesh,
+                     double ground_level,
+                     double layerheight = 0.1);
+    ~BasePlateSampler();
+
+    /// Calculate the silhouette from the levels in the [zmin, zmax) range
+    void base_plate(ExPolygons& output,             // Output will be merged with
+                    double zmin,                    // Lowest level to sample
+                    double zmax,                    // Levels are sampled below
+                    ThrowOnCancel thrfn = [](){});  // Will be called frequently
+
+private:
+    const TriangleMesh *m_mesh;
+    double m_ground_level;
+    double m_layerheight;
+    std::unique_ptr<TriangleMeshSlicer> m_slicer;
+    long m_first = 0;                       // Index of the first kept level
+    std::vector<ExPolygons> m_levels;       // Simplified slices of the levels
+};
+
 // Function to cut tiny connector cavities for a given polygon. The input poly
 // will be offsetted by "padding" and small rectangle shaped cavities will be
 // inserted along the perimeter in every "stride" distance. The stick rectangles
@@ -602,7 +602,8 @@ struct Pad {
     Pad(const TriangleMesh& support_mesh,
         const ExPolygons& modelbase,
         double ground_level,
-        const PoolConfig& pcfg) :
+        const PoolConfig& pcfg,
+        BasePlateSampler *sampler = nullptr) :
         cfg(pcfg),
         zlevel(ground_level +
                sla::get_pad_fullheight(pcfg) -
@@ -620,7 +621,10 @@ struct Pad {
             float zstart = float(zlevel);
             float zend   = zstart + float(get_pad_fullheight(pcfg) + EPSILON);
 
-            base_plate(support_mesh, platetmp, grid(zstart, zend, 0.1f), thr);
+            if (sampler)
+                sampler->base_plate(platetmp, zstart, zend, thr);
+            else
+                base_plate(support_mesh, platetmp, grid(zstart, zend, 0.1f), thr);
 
             // We don't need no... holes control...
             for (const ExPolygon &bp : platetmp)
@@ -784,6 +788,11 @@ class SLASupportTree::Impl {
 
     Pad m_pad;
 
+    // Samples the base plate of the pad from the merged mesh. The sampled
+    // levels do not depend on the pad configuration, so it is kept until the
+    // merged mesh changes.
+    mutable std::unique_ptr<BasePlateSampler> m_pad_sampler;
+
     using Mutex = ccr::Mutex;
 
     mutable Mutex m_mutex;
@@ -935,7 +944,14 @@ public:
                           const ExPolygons &  modelbase,
                           const PoolConfig &  cfg)
     {
-        m_pad = Pad(object_supports, modelbase, ground_level, cfg);
+        bool use_sampler = &object_supports == &meshcache && meshcache_valid &&
+                           !object_supports.empty();
+
+        if (use_sampler && !m_pad_sampler)
+            m_pad_sampler.reset(new BasePlateSampler(object_supports, ground_level));
+
+        m_pad = Pad(object_supports, modelbase, ground_level, cfg,
+                    use_sampler ? m_pad_sampler.get() : nullptr);
         return m_pad;
     }
 
@@ -948,6 +964,8 @@ public:
     {
         if (meshcache_valid) return meshcache;
 
+        m_pad_sampler.reset();
+
         Contour3D merged;
 
         for (auto &head : m_heads) {
@@ -219,9 +219,12 @@ SLAPrint::ApplyStatus SLAPrint::apply(const Model &model, DynamicPrintConfig con
         ObjectID                id;
         Status                  status;
         // Search by id.
-        bool operator<(const ModelObjectStatus &rhs) const { return id < rhs.id; }
+        bool operator==(const ModelObjectStatus &rhs) const { return id == rhs.id; }
     };
-    std::set<ModelObjectStatus> model_object_status;
+    struct ModelObjectStatusHash {
+        size_t operator()(const ModelObjectStatus &status) const { return ObjectIDHash()(status.id); }
+    };
+    std::unordered_set<ModelObjectStatus, ModelObjectStatusHash> model_object_status;
 
     // 1) Synchronize model objects.
     if (model.id() != m_model.id() || invalidate_all_model_objects) {
@@ -724,6 +727,8 @@ void SLAPrint::process()
 
     if(m_objects.empty()) return;
 
+    m_report_status.reset();
+
     // Assumption: at this point the print objects should be populated only with
     // the model objects we have to process and the instances are also filtered
 
@@ -1507,35 +1512,54 @@ void SLAPrint::process()
 
     std::array<double, slaposCount + slapsCount> step_times {};
 
+    // Guards st and step_times, which are updated by the objects processed in parallel.
+    std::mutex st_mutex;
+
+    // The objects are processed in parallel, each object runs its steps in order,
+    // so that for example the support tree generation of one object overlaps
+    // with the slicing of another object.
     auto apply_steps_on_objects =
-        [this, &st, ostepd, &pobj_program, &step_times, &bench]
+        [this, &st, &st_mutex, ostepd, &pobj_program, &step_times]
         (const std::vector<SLAPrintObjectStep> &steps)
     {
-        unsigned incr = 0;
-        for (SLAPrintObject *po : m_objects) {
-            for (SLAPrintObjectStep step : steps) {
-
-                // Cancellation checking. Each step will check for
-                // cancellation on its own and return earlier gracefully.
-                // Just after it returns execution gets to this point and
-                // throws the canceled signal.
-                throw_if_canceled();
-
-                st += incr * ostepd;
-
-                if (po->m_stepmask[step] && po->set_started(step)) {
-                    m_report_status(*this, st, OBJ_STEP_LABELS(step));
-                    bench.start();
-                    pobj_program[step](*po);
-                    bench.stop();
-                    step_times[step] += bench.getElapsedSec();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, m_objects.size(), 1),
+            [this, &st, &st_mutex, ostepd, &pobj_program, &step_times, &steps]
+            (const tbb::blocked_range<size_t> &range)
+        {
+            for (size_t idx = range.begin(); idx < range.end(); ++ idx) {
+                SLAPrintObject *po = m_objects[idx];
+                for (SLAPrintObjectStep step : steps) {
+
+                    // Cancellation checking. Each step will check for
+                    // cancellation on its own and return earlier gracefully.
+                    // Just after it returns execution gets to this point and
+                    // throws the canceled signal.
                     throw_if_canceled();
-                    po->set_done(step);
-                }
 
-                incr = OBJ_STEP_LEVELS[step];
+                    if (po->m_stepmask[step] && po->set_started(step)) {
+                        double current_st;
+                        {
+                            std::lock_guard<std::mutex> lock(st_mutex);
+                            current_st = st;
+                        }
+                        m_report_status(*this, current_st, OBJ_STEP_LABELS(step));
+                        decltype(bench) step_bench;
+                        step_bench.start();
+                        pobj_program[step](*po);
+                        step_bench.stop();
+                        {
+                            std::lock_guard<std::mutex> lock(st_mutex);
+                            step_times[step] += step_bench.getElapsedSec();
+                        }
+                        throw_if_canceled();
+                        po->set_done(step);
+                    }
+
+                    std::lock_guard<std::mutex> lock(st_mutex);
+                    st += OBJ_STEP_LEVELS[step] * ostepd;
+                }
             }
-        }
+        }, tbb::simple_partitioner());
     };
 
     apply_steps_on_objects(level1_obj_steps);
@@ -1975,7 +1999,10 @@ void SLAPrint::StatusReporter::operator()(SLAPrint &         p,
                                           unsigned           flags,
                                           const std::string &logmsg)
 {
-    m_st = st;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Negative status values do not update the progress bar.
+    if (st >= 0)
+        st = m_st = std::max(m_st, st);
     BOOST_LOG_TRIVIAL(info)
         << st << "% " << msg << (logmsg.empty() ? "" : ": ") << logmsg
         << log_memory_info();
@@ -445,9 +445,12 @@ private:
     // Estimated print time, material consumed.
     SLAPrintStatistics                      m_print_statistics;
     
+    // Called concurrently by the print objects processed in parallel,
+    // the reported progress is kept monotonic.
     class StatusReporter
     {
-        double m_st = 0;
+        std::mutex m_mutex;
+        double     m_st = 0;
         
     public:
         void operator()(SLAPrint &         p,
@@ -456,7 +459,8 @@ private:
                         unsigned           flags = SlicingStatus::DEFAULT,
                         const std::string &logmsg = "");
         
-        double status() const { return m_st; }
+        double status() { std::lock_guard<std::mutex> lock(m_mutex); return m_st; }
+        void   reset()  { std::lock_guard<std::mutex> lock(m_mutex); m_st = 0; }
     } m_report_status;
 
 	friend SLAPrintObject;
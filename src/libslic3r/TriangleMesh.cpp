@@ -478,6 +478,55 @@ void TriangleMesh::merge(const TriangleMesh &mesh)
     stl_get_size(&this->stl);
 }
 
+void TriangleMesh::merge(TriangleMesh &&mesh)
+{
+    if (this->stl.stats.number_of_facets > 0) {
+        this->merge(mesh);
+        return;
+    }
+
+    // Nothing to merge with, take over the facets instead of copying them.
+    this->its.clear();
+    this->repaired = false;
+    this->stl.stats.number_of_facets = mesh.stl.stats.number_of_facets;
+    this->stl.stats.original_num_facets = this->stl.stats.number_of_facets;
+    this->stl.facet_start = std::move(mesh.stl.facet_start);
+    this->stl.neighbors_start.clear();
+    stl_reallocate(&this->stl);
+    mesh.clear();
+    
+    // update size
+    stl_get_size(&this->stl);
+}
+
+void TriangleMesh::merge(const TriangleMesh &mesh, const Transform3d &trafo)
+{
+    // reset stats and metadata
+    int number_of_facets = this->stl.stats.number_of_facets;
+    this->its.clear();
+    this->repaired = false;
+    
+    // update facet count and allocate more memory
+    this->stl.stats.number_of_facets = number_of_facets + mesh.stl.stats.number_of_facets;
+    this->stl.stats.original_num_facets = this->stl.stats.number_of_facets;
+    stl_reallocate(&this->stl);
+    
+    // copy the transformed facets, the same way stl_transform() transforms them
+    const Eigen::Matrix<double, 3, 3, Eigen::DontAlign> r = trafo.matrix().block<3, 3>(0, 0);
+    for (uint32_t i = 0; i < mesh.stl.stats.number_of_facets; ++ i) {
+        const stl_facet &src = mesh.stl.facet_start[i];
+        stl_facet       &dst = this->stl.facet_start[number_of_facets + i];
+        for (size_t j = 0; j < 3; ++ j)
+            dst.vertex[j] = (trafo * src.vertex[j].cast<double>()).cast<float>().eval();
+        dst.normal   = (r * src.normal.cast<double>()).cast<float>().eval();
+        dst.extra[0] = src.extra[0];
+        dst.extra[1] = src.extra[1];
+    }
+    
+    // update size
+    stl_get_size(&this->stl);
+}
+
 // Calculate projection of the mesh into the XY plane, in scaled coordinates.
 //FIXME This could be extremely slow! Use it for tiny meshes only!
 ExPolygons TriangleMesh::horizontal_projection() const
@@ -648,11 +697,40 @@ void TriangleMeshSlicer::init(const TriangleMesh *_mesh, throw_on_cancel_callbac
         throw std::invalid_argument("TriangleMeshSlicer was passed a mesh without shared vertices.");
 
     throw_on_cancel();
-    facets_edges.assign(_mesh->stl.stats.number_of_facets * 3, -1);
+    m_transformed = false;
+    m_flipped     = false;
+    v_transformed_shared.clear();
 	v_scaled_shared.assign(_mesh->its.vertices.size(), stl_vertex());
 	for (size_t i = 0; i < v_scaled_shared.size(); ++ i)
         this->v_scaled_shared[i] = _mesh->its.vertices[i] / float(SCALING_FACTOR);
 
+    this->facets_edges = make_facets_edges(_mesh->its, throw_on_cancel);
+}
+
+void TriangleMeshSlicer::init(const TriangleMesh *_mesh, const Transform3d &trafo, throw_on_cancel_callback_type throw_on_cancel, FacetsEdgesPtr facets_edges)
+{
+    mesh = _mesh;
+    if (! mesh->has_shared_vertices())
+        throw std::invalid_argument("TriangleMeshSlicer was passed a mesh without shared vertices.");
+
+    throw_on_cancel();
+    m_transformed = true;
+    m_flipped     = trafo.matrix().block(0, 0, 3, 3).determinant() < 0.;
+    v_transformed_shared.assign(_mesh->its.vertices.size(), stl_vertex());
+	v_scaled_shared.assign(_mesh->its.vertices.size(), stl_vertex());
+	for (size_t i = 0; i < v_scaled_shared.size(); ++ i) {
+        this->v_transformed_shared[i] = (trafo * _mesh->its.vertices[i].cast<double>()).cast<float>();
+        this->v_scaled_shared[i]      = this->v_transformed_shared[i] / float(SCALING_FACTOR);
+    }
+
+    assert(! facets_edges || facets_edges->size() == _mesh->its.indices.size() * 3);
+    this->facets_edges = facets_edges ? std::move(facets_edges) : make_facets_edges(_mesh->its, throw_on_cancel);
+}
+
+TriangleMeshSlicer::FacetsEdgesPtr TriangleMeshSlicer::make_facets_edges(const indexed_triangle_set &its, throw_on_cancel_callback_type throw_on_cancel)
+{
+    std::vector<int> facets_edges(its.indices.size() * 3, -1);
+
     // Create a mapping from triangle edge into face.
     struct EdgeToFace {
         // Index of the 1st vertex of the triangle edge. vertex_low <= vertex_high.
@@ -667,12 +745,12 @@ void TriangleMeshSlicer::init(const TriangleMesh *_mesh, throw_on_cancel_callbac
         bool operator<(const EdgeToFace &other) const { return vertex_low < other.vertex_low || (vertex_low == other.vertex_low && vertex_high < other.vertex_high); }
     };
     std::vector<EdgeToFace> edges_map;
-    edges_map.assign(this->mesh->stl.stats.number_of_facets * 3, EdgeToFace());
-    for (uint32_t facet_idx = 0; facet_idx < this->mesh->stl.stats.number_of_facets; ++ facet_idx)
+    edges_map.assign(its.indices.size() * 3, EdgeToFace());
+    for (uint32_t facet_idx = 0; facet_idx < its.indices.size(); ++ facet_idx)
         for (int i = 0; i < 3; ++ i) {
             EdgeToFace &e2f = edges_map[facet_idx*3+i];
-            e2f.vertex_low  = this->mesh->its.indices[facet_idx][i];
-            e2f.vertex_high = this->mesh->its.indices[facet_idx][(i + 1) % 3];
+            e2f.vertex_low  = its.indices[facet_idx][i];
+            e2f.vertex_high = its.indices[facet_idx][(i + 1) % 3];
             e2f.face        = facet_idx;
             // 1 based indexing, to be always strictly positive.
             e2f.face_edge   = i + 1;
@@ -715,10 +793,10 @@ void TriangleMeshSlicer::init(const TriangleMesh *_mesh, throw_on_cancel_callbac
                 }
         }
         // Assign an edge index to the 1st face.
-        this->facets_edges[edge_i.face * 3 + std::abs(edge_i.face_edge) - 1] = num_edges;
+        facets_edges[edge_i.face * 3 + std::abs(edge_i.face_edge) - 1] = num_edges;
         if (found) {
             EdgeToFace &edge_j = edges_map[j];
-            this->facets_edges[edge_j.face * 3 + std::abs(edge_j.face_edge) - 1] = num_edges;
+            facets_edges[edge_j.face * 3 + std::abs(edge_j.face_edge) - 1] = num_edges;
             // Mark the edge as connected.
             edge_j.face = -1;
         }
@@ -726,9 +804,22 @@ void TriangleMeshSlicer::init(const TriangleMesh *_mesh, throw_on_cancel_callbac
         if ((i & 0x0ffff) == 0)
             throw_on_cancel();
     }
+    return std::make_shared<const std::vector<int>>(std::move(facets_edges));
 }
 
-
+stl_facet TriangleMeshSlicer::facet(size_t facet_idx) const
+{
+    if (! m_transformed)
+        return this->mesh->stl.facet_start[facet_idx];
+    stl_triangle_vertex_indices vertices = this->facet_vertices(facet_idx);
+    stl_facet facet;
+    for (int i = 0; i < 3; ++ i)
+        facet.vertex[i] = this->v_transformed_shared[vertices(i)];
+    // Only the direction of the normal is used by the slicer.
+    facet.normal = (facet.vertex[1] - facet.vertex[0]).cross(facet.vertex[2] - facet.vertex[0]);
+    facet.extra[0] = facet.extra[1] = 0;
+    return facet;
+}
 
 void TriangleMeshSlicer::set_up_direction(const Vec3f& up)
 {
@@ -774,7 +865,7 @@ void TriangleMeshSlicer::slice(const std::vector<float> &z, std::vector<Polygons
     {
         boost::mutex lines_mutex;
         tbb::parallel_for(
-            tbb::blocked_range<int>(0,this->mesh->stl.stats.number_of_facets),
+            tbb::blocked_range<int>(0, int(this->mesh->its.indices.size())),
             [&lines, &lines_mutex, &z, throw_on_cancel, this](const tbb::blocked_range<int>& range) {
                 for (int facet_idx = range.begin(); facet_idx < range.end(); ++ facet_idx) {
                     if ((facet_idx & 0x0ffff) == 0)
@@ -840,7 +931,7 @@ void TriangleMeshSlicer::slice(const std::vector<float> &z, std::vector<Polygons
 void TriangleMeshSlicer::_slice_do(size_t facet_idx, std::vector<IntersectionLines>* lines, boost::mutex* lines_mutex, 
     const std::vector<float> &z) const
 {
-    const stl_facet &facet = m_use_quaternion ? (this->mesh->stl.facet_start.data() + facet_idx)->rotated(m_quaternion) : *(this->mesh->stl.facet_start.data() + facet_idx);
+    const stl_facet facet = m_use_quaternion ? this->facet(facet_idx).rotated(m_quaternion) : this->facet(facet_idx);
     
     // find facet extents
     const float min_z = fminf(facet.vertex[0](2), fminf(facet.vertex[1](2), facet.vertex[2](2)));
@@ -909,7 +1000,7 @@ TriangleMeshSlicer::FacetSliceType TriangleMeshSlicer::slice_facet(
     // Reorder vertices so that the first one is the one with lowest Z.
     // This is needed to get all intersection lines in a consistent order
     // (external on the right of the line)
-    const stl_triangle_vertex_indices &vertices = this->mesh->its.indices[facet_idx];
+    const stl_triangle_vertex_indices  vertices = this->facet_vertices(facet_idx);
     int i = (facet.vertex[1].z() == min_z) ? 1 : ((facet.vertex[2].z() == min_z) ? 2 : 0);
 
     // These are used only if the cut plane is tilted:
@@ -917,7 +1008,7 @@ TriangleMeshSlicer::FacetSliceType TriangleMeshSlicer::slice_facet(
     stl_vertex rotated_b;
 
     for (int j = i; j - i < 3; ++j) {  // loop through facet edges
-        int        edge_id  = this->facets_edges[facet_idx * 3 + (j % 3)];
+        int        edge_id  = this->facet_edge(facet_idx, j % 3);
         int        a_id     = vertices[j % 3];
         int        b_id     = vertices[(j+1) % 3];
 
@@ -1733,6 +1824,8 @@ void TriangleMeshSlicer::cut(float z, TriangleMesh* upper, TriangleMesh* lower)
 {
     IntersectionLines upper_lines, lower_lines;
     
+    // The cut works on the facets of the mesh, which are not transformed.
+    assert(! m_transformed);
     BOOST_LOG_TRIVIAL(trace) << "TriangleMeshSlicer::cut - slicing object";
     float scaled_z = scale_(z);
     for (uint32_t facet_idx = 0; facet_idx < this->mesh->stl.stats.number_of_facets; ++ facet_idx) {
@@ -4,6 +4,7 @@
 #include "libslic3r.h"
 #include <admesh/stl.h>
 #include <functional>
+#include <memory>
 #include <vector>
 #include <boost/thread.hpp>
 #include "BoundingBox.hpp"
@@ -51,6 +52,13 @@ public:
     void rotate(double angle, Point* center);
     TriangleMeshPtrs split() const;
     void merge(const TriangleMesh &mesh);
+    // Reserve space for merging meshes with num_facets facets in total, so that the merging does not reallocate.
+    void reserve(size_t num_facets) { this->stl.facet_start.reserve(num_facets); this->stl.neighbors_start.reserve(num_facets); }
+    // Merge the facets of mesh, taking them over if this mesh is empty.
+    void merge(TriangleMesh &&mesh);
+    // Merge the facets of mesh transformed by trafo. Produces the same facets as transforming a copy of mesh
+    // and merging it, however without materializing the transformed copy.
+    void merge(const TriangleMesh &mesh, const Transform3d &trafo);
     ExPolygons horizontal_projection() const;
     const float* first_vertex() const { return this->stl.facet_start.empty() ? nullptr : &this->stl.facet_start.front().vertex[0](0); }
     // 2D convex hull of a 3D mesh projected into the Z=0 plane.
@@ -159,9 +167,20 @@ class TriangleMeshSlicer
 {
 public:
     typedef std::function<void()> throw_on_cancel_callback_type;
+    // Map from a facet to an edge index. It only depends on the mesh topology, not on the mesh transformation,
+    // therefore it may be shared by slicers of the same mesh with different transformations.
+    typedef std::shared_ptr<const std::vector<int>> FacetsEdgesPtr;
+
     TriangleMeshSlicer() : mesh(nullptr) {}
 	TriangleMeshSlicer(const TriangleMesh* mesh) { this->init(mesh, [](){}); }
     void init(const TriangleMesh *mesh, throw_on_cancel_callback_type throw_on_cancel);
+    // Slice the mesh transformed by trafo without making a transformed copy of the mesh. The transformation is applied
+    // while scaling the vertices, the faces are reversed on the fly for a left handed transformation.
+    // If facets_edges is not null, it has to be the facets_edges() of a slicer initialized with the same mesh.
+    void init(const TriangleMesh *mesh, const Transform3d &trafo, throw_on_cancel_callback_type throw_on_cancel, FacetsEdgesPtr facets_edges = FacetsEdgesPtr());
+    const FacetsEdgesPtr& get_facets_edges() const { return facets_edges; }
+    // Build the map from a facet to an edge index of a mesh with shared vertices.
+    static FacetsEdgesPtr make_facets_edges(const indexed_triangle_set &its, throw_on_cancel_callback_type throw_on_cancel);
     void slice(const std::vector<float> &z, std::vector<Polygons>* layers, throw_on_cancel_callback_type throw_on_cancel) const;
     void slice(const std::vector<float> &z, const float closing_radius, std::vector<ExPolygons>* layers, throw_on_cancel_callback_type throw_on_cancel) const;
     enum FacetSliceType {
@@ -177,15 +196,27 @@ public:
 private:
     const TriangleMesh      *mesh;
     // Map from a facet to an edge index.
-    std::vector<int>         facets_edges;
-    // Scaled copy of this->mesh->stl.v_shared
+    FacetsEdgesPtr           facets_edges;
+    // Scaled copy of this->mesh->stl.v_shared, transformed if initialized with a transformation.
     std::vector<stl_vertex>  v_scaled_shared;
+    // If initialized with a transformation: Unscaled transformed copy of this->mesh->its.vertices.
+    // The facets of this->mesh->stl are not valid for slicing in that case.
+    std::vector<stl_vertex>  v_transformed_shared;
+    bool                     m_transformed = false;
+    // The transformation is left handed, the order of the facet vertices is reversed.
+    bool                     m_flipped     = false;
     // Quaternion that will be used to rotate every facet before the slicing
     Eigen::Quaternion<float, Eigen::DontAlign> m_quaternion;
     // Whether or not the above quaterion should be used
     bool                     m_use_quaternion = false;
 
     void _slice_do(size_t facet_idx, std::vector<IntersectionLines>* lines, boost::mutex* lines_mutex, const std::vector<float> &z) const;
+    // Vertex indices of a facet, and the edge index of the i-th edge of a facet, respecting m_flipped.
+    stl_triangle_vertex_indices facet_vertices(size_t facet_idx) const
+        { stl_triangle_vertex_indices v = this->mesh->its.indices[facet_idx]; if (m_flipped) std::swap(v(1), v(2)); return v; }
+    int            facet_edge(size_t facet_idx, int i) const { return (*facets_edges)[facet_idx * 3 + (m_flipped ? 2 - i : i)]; }
+    // Facet to be sliced, transformed if initialized with a transformation.
+    stl_facet      facet(size_t facet_idx) const;
     void make_loops(std::vector<IntersectionLine> &lines, Polygons* loops) const;
     void make_expolygons(const Polygons &loops, const float closing_radius, ExPolygons* slices) const;
     void make_expolygons_simple(std::vector<IntersectionLine> &lines, ExPolygons* slices) const;
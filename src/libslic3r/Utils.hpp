@@ -66,6 +66,11 @@ extern std::error_code rename_file(const std::string &from, const std::string &t
 // Copy a file, adjust the access attributes, so that the target is writable.
 extern int copy_file(const std::string &from, const std::string &to);
 
+// Read the whole content of a binary file. Returns false if the file could not be read.
+extern bool load_file(const std::string &path, std::vector<char> &out);
+// 64bit FNV-1a hash of a buffer. Hash of multiple buffers is calculated by passing the hash of the preceding buffers as seed.
+extern uint64_t hash_fnv1a(const void *data, size_t len, uint64_t seed = 0xcbf29ce484222325ull);
+
 // Ignore system and hidden files, which may be created by the DropBox synchronisation process.
 // https://github.com/prusa3d/PrusaSlicer/issues/1298
 extern bool is_plain_file(const boost::filesystem::directory_entry &path);
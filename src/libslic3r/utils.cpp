@@ -434,6 +434,32 @@ int copy_file(const std::string &from, const std::string &to)
     return 0;
 }
 
+bool load_file(const std::string &path, std::vector<char> &out)
+{
+    FILE *file = boost::nowide::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    bool ok = ::fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? ::ftell(file) : -1;
+    ok = size >= 0 && ::fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        out.assign(size_t(size), 0);
+        ok = ::fread(out.data(), 1, out.size(), file) == out.size();
+    }
+    ::fclose(file);
+    return ok;
+}
+
+uint64_t hash_fnv1a(const void *data, size_t len, uint64_t seed)
+{
+    uint64_t hash = seed;
+    for (const unsigned char *p = (const unsigned char*)data, *end = p + len; p != end; ++ p) {
+        hash ^= *p;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
 // Ignore system and hidden files, which may be created by the DropBox synchronisation process.
 // https://github.com/prusa3d/PrusaSlicer/issues/1298
 bool is_plain_file(const boost::filesystem::directory_entry &dir_entry)
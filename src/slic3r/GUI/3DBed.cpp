@@ -420,7 +420,19 @@ void Bed3D::render_texture(const std::string& filename, bool bottom, GLCanvas3D&
         {
             // use higher resolution images if graphic card and opengl version allow
             GLint max_tex_size = GLCanvas3DManager::get_gl_info().get_max_tex_size();
-            if ((m_temp_texture.get_id() == 0) || (m_temp_texture.get_source() != filename))
+
+            // starts generating the main texture, compression will run asynchronously
+            // if the compressed texture was cached, it is ready right away
+            if (!m_texture.load_from_svg_file(filename, true, true, true, max_tex_size))
+            {
+                render_default(bottom);
+                return;
+            }
+
+            if (m_texture.all_compressed_data_sent_to_gpu())
+                // the main texture was loaded from cache, the temporary texture is not needed
+                m_temp_texture.reset();
+            else if ((m_temp_texture.get_id() == 0) || (m_temp_texture.get_source() != filename))
             {
                 // generate a temporary lower resolution texture to show while no main texture levels have been compressed
                 if (!m_temp_texture.load_from_svg_file(filename, false, false, false, max_tex_size / 8))
@@ -429,32 +441,29 @@ void Bed3D::render_texture(const std::string& filename, bool bottom, GLCanvas3D&
                     return;
                 }
             }
-
+        }
+        else if (boost::algorithm::iends_with(filename, ".png"))
+        {
             // starts generating the main texture, compression will run asynchronously
-            if (!m_texture.load_from_svg_file(filename, true, true, true, max_tex_size))
+            // if the compressed texture was cached, it is ready right away
+            if (!m_texture.load_from_file(filename, true, GLTexture::MultiThreaded, true))
             {
                 render_default(bottom);
                 return;
             }
-        }
-        else if (boost::algorithm::iends_with(filename, ".png"))
-        {
-            // generate a temporary lower resolution texture to show while no main texture levels have been compressed
-            if ((m_temp_texture.get_id() == 0) || (m_temp_texture.get_source() != filename))
+
+            if (m_texture.all_compressed_data_sent_to_gpu())
+                // the main texture was loaded from cache, the temporary texture is not needed
+                m_temp_texture.reset();
+            else if ((m_temp_texture.get_id() == 0) || (m_temp_texture.get_source() != filename))
             {
+                // generate a temporary lower resolution texture to show while no main texture levels have been compressed
                 if (!m_temp_texture.load_from_file(filename, false, GLTexture::None, false))
                 {
                     render_default(bottom);
                     return;
                 }
             }
-
-            // starts generating the main texture, compression will run asynchronously
-            if (!m_texture.load_from_file(filename, true, GLTexture::MultiThreaded, true))
-            {
-                render_default(bottom);
-                return;
-            }
         }
         else
         {
@@ -1402,6 +1402,57 @@ static void thick_lines_to_indexed_vertex_array(
 #undef BOTTOM
 }
 
+// Coarse variant of the above for the coarse levels of detail of the toolpaths preview, where an extrusion covers
+// just a few pixels on the screen. The cross section of the extrusion is a triangle (top, left, right) instead of
+// a diamond, the bottom faces are merged into the top faces. All the vertices are shared by the neighbor segments,
+// there are no caps and no wedges at the sharp turns, so each segment adds three vertices and two quads only.
+static void thick_lines_to_indexed_vertex_array_coarse(
+    const Lines                 &lines, 
+    const std::vector<double>   &widths,
+    const std::vector<double>   &heights, 
+    bool                         closed,
+    double                       top_z,
+    GLIndexedVertexArray        &volume)
+{
+    if (lines.empty())
+        return;
+
+    // Closed loops share the first point with the end of the last line.
+    size_t num_points = closed ? lines.size() : lines.size() + 1;
+    int    idx_first  = int(volume.vertices_and_normals_interleaved.size() / 6);
+    for (size_t k = 0; k < num_points; ++ k) {
+        // Lines starting and ending at this point.
+        size_t      i_out = (k < lines.size()) ? k : lines.size() - 1;
+        size_t      i_in  = (k > 0) ? k - 1 : (closed ? lines.size() - 1 : 0);
+        Vec2d       p     = unscale((k < lines.size()) ? lines[k].a : lines.back().b);
+        // Average of the right hand side directions of the two lines.
+        Vec2d       v_in  = unscale(lines[i_in ].vector()).normalized();
+        Vec2d       v_out = unscale(lines[i_out].vector()).normalized();
+        Vec2d       right(v_in(1) + v_out(1), - v_in(0) - v_out(0));
+        if (right.squaredNorm() < EPSILON)
+            // Reversal of the direction.
+            right = Vec2d(v_out(1), - v_out(0));
+        right.normalize();
+        double      width    = widths[i_out];
+        double      middle_z = top_z - 0.5 * heights[i_out];
+        Vec2d       a1       = p + 0.5 * width * right;
+        Vec2d       a2       = p - 0.5 * width * right;
+        volume.push_geometry(p(0), p(1), top_z, 0., 0., 1.);
+        volume.push_geometry(a1(0), a1(1), middle_z, right(0), right(1), 0.);
+        volume.push_geometry(a2(0), a2(1), middle_z, - right(0), - right(1), 0.);
+    }
+
+    // top, right, left vertices of a point
+    for (size_t i = 0; i < lines.size(); ++ i) {
+        int idx_a = idx_first + 3 * int(i);
+        int idx_b = idx_first + 3 * int((i + 1 == num_points) ? 0 : i + 1);
+        // top-right face
+        volume.push_quad(idx_a + 1, idx_b + 1, idx_b, idx_a);
+        // top-left face
+        volume.push_quad(idx_a, idx_b, idx_b + 2, idx_a + 2);
+    }
+}
+
 // caller is responsible for supplying NO lines with zero length
 static void thick_lines_to_indexed_vertex_array(const Lines3& lines,
     const std::vector<double>& widths,
@@ -1700,6 +1751,17 @@ void _3DScene::thick_lines_to_verts(
     thick_lines_to_indexed_vertex_array(lines, widths, heights, closed, top_z, volume.indexed_vertex_array);
 }
 
+void _3DScene::thick_lines_to_verts_coarse(
+    const Lines                 &lines,
+    const std::vector<double>   &widths,
+    const std::vector<double>   &heights, 
+    bool                         closed,
+    double                       top_z,
+    GLVolume                    &volume)
+{
+    thick_lines_to_indexed_vertex_array_coarse(lines, widths, heights, closed, top_z, volume.indexed_vertex_array);
+}
+
 void _3DScene::thick_lines_to_verts(const Lines3& lines,
     const std::vector<double>& widths,
     const std::vector<double>& heights,
@@ -1727,19 +1789,24 @@ void _3DScene::extrusionentity_to_verts(const ExtrusionPath &extrusion_path, flo
 }
 
 // Fill in the qverts and tverts with quads and triangles for the extrusion_path.
-void _3DScene::extrusionentity_to_verts(const ExtrusionPath &extrusion_path, float print_z, const Point &copy, GLVolume &volume)
+void _3DScene::extrusionentity_to_verts(const ExtrusionPath &extrusion_path, float print_z, const Point &copy, GLVolume &volume, double lod_tolerance, bool lod_coarse)
 {
     Polyline            polyline = extrusion_path.polyline;
     polyline.remove_duplicate_points();
+    if (lod_tolerance > 0.)
+        polyline.simplify(lod_tolerance);
     polyline.translate(copy);
     Lines               lines = polyline.lines();
     std::vector<double> widths(lines.size(), extrusion_path.width);
     std::vector<double> heights(lines.size(), extrusion_path.height);
-    thick_lines_to_verts(lines, widths, heights, false, print_z, volume);
+    if (lod_coarse)
+        thick_lines_to_verts_coarse(lines, widths, heights, false, print_z, volume);
+    else
+        thick_lines_to_verts(lines, widths, heights, false, print_z, volume);
 }
 
 // Fill in the qverts and tverts with quads and triangles for the extrusion_loop.
-void _3DScene::extrusionentity_to_verts(const ExtrusionLoop &extrusion_loop, float print_z, const Point &copy, GLVolume &volume)
+void _3DScene::extrusionentity_to_verts(const ExtrusionLoop &extrusion_loop, float print_z, const Point &copy, GLVolume &volume, double lod_tolerance, bool lod_coarse)
 {
     Lines               lines;
     std::vector<double> widths;
@@ -1747,17 +1814,22 @@ void _3DScene::extrusionentity_to_verts(const ExtrusionLoop &extrusion_loop, flo
     for (const ExtrusionPath &extrusion_path : extrusion_loop.paths) {
         Polyline            polyline = extrusion_path.polyline;
         polyline.remove_duplicate_points();
+        if (lod_tolerance > 0.)
+            polyline.simplify(lod_tolerance);
         polyline.translate(copy);
         Lines lines_this = polyline.lines();
         append(lines, lines_this);
         widths.insert(widths.end(), lines_this.size(), extrusion_path.width);
         heights.insert(heights.end(), lines_this.size(), extrusion_path.height);
     }
-    thick_lines_to_verts(lines, widths, heights, true, print_z, volume);
+    if (lod_coarse)
+        thick_lines_to_verts_coarse(lines, widths, heights, true, print_z, volume);
+    else
+        thick_lines_to_verts(lines, widths, heights, true, print_z, volume);
 }
 
 // Fill in the qverts and tverts with quads and triangles for the extrusion_multi_path.
-void _3DScene::extrusionentity_to_verts(const ExtrusionMultiPath &extrusion_multi_path, float print_z, const Point &copy, GLVolume &volume)
+void _3DScene::extrusionentity_to_verts(const ExtrusionMultiPath &extrusion_multi_path, float print_z, const Point &copy, GLVolume &volume, double lod_tolerance, bool lod_coarse)
 {
     Lines               lines;
     std::vector<double> widths;
@@ -1765,39 +1837,44 @@ void _3DScene::extrusionentity_to_verts(const ExtrusionMultiPath &extrusion_mult
     for (const ExtrusionPath &extrusion_path : extrusion_multi_path.paths) {
         Polyline            polyline = extrusion_path.polyline;
         polyline.remove_duplicate_points();
+        if (lod_tolerance > 0.)
+            polyline.simplify(lod_tolerance);
         polyline.translate(copy);
         Lines lines_this = polyline.lines();
         append(lines, lines_this);
         widths.insert(widths.end(), lines_this.size(), extrusion_path.width);
         heights.insert(heights.end(), lines_this.size(), extrusion_path.height);
     }
-    thick_lines_to_verts(lines, widths, heights, false, print_z, volume);
+    if (lod_coarse)
+        thick_lines_to_verts_coarse(lines, widths, heights, false, print_z, volume);
+    else
+        thick_lines_to_verts(lines, widths, heights, false, print_z, volume);
 }
 
-void _3DScene::extrusionentity_to_verts(const ExtrusionEntityCollection &extrusion_entity_collection, float print_z, const Point &copy, GLVolume &volume)
+void _3DScene::extrusionentity_to_verts(const ExtrusionEntityCollection &extrusion_entity_collection, float print_z, const Point &copy, GLVolume &volume, double lod_tolerance, bool lod_coarse)
 {
     for (const ExtrusionEntity *extrusion_entity : extrusion_entity_collection.entities)
-        extrusionentity_to_verts(extrusion_entity, print_z, copy, volume);
+        extrusionentity_to_verts(extrusion_entity, print_z, copy, volume, lod_tolerance, lod_coarse);
 }
 
-void _3DScene::extrusionentity_to_verts(const ExtrusionEntity *extrusion_entity, float print_z, const Point &copy, GLVolume &volume)
+void _3DScene::extrusionentity_to_verts(const ExtrusionEntity *extrusion_entity, float print_z, const Point &copy, GLVolume &volume, double lod_tolerance, bool lod_coarse)
 {
     if (extrusion_entity != nullptr) {
         auto *extrusion_path = dynamic_cast<const ExtrusionPath*>(extrusion_entity);
         if (extrusion_path != nullptr)
-            extrusionentity_to_verts(*extrusion_path, print_z, copy, volume);
+            extrusionentity_to_verts(*extrusion_path, print_z, copy, volume, lod_tolerance, lod_coarse);
         else {
             auto *extrusion_loop = dynamic_cast<const ExtrusionLoop*>(extrusion_entity);
             if (extrusion_loop != nullptr)
-                extrusionentity_to_verts(*extrusion_loop, print_z, copy, volume);
+                extrusionentity_to_verts(*extrusion_loop, print_z, copy, volume, lod_tolerance, lod_coarse);
             else {
                 auto *extrusion_multi_path = dynamic_cast<const ExtrusionMultiPath*>(extrusion_entity);
                 if (extrusion_multi_path != nullptr)
-                    extrusionentity_to_verts(*extrusion_multi_path, print_z, copy, volume);
+                    extrusionentity_to_verts(*extrusion_multi_path, print_z, copy, volume, lod_tolerance, lod_coarse);
                 else {
                     auto *extrusion_entity_collection = dynamic_cast<const ExtrusionEntityCollection*>(extrusion_entity);
                     if (extrusion_entity_collection != nullptr)
-                        extrusionentity_to_verts(*extrusion_entity_collection, print_z, copy, volume);
+                        extrusionentity_to_verts(*extrusion_entity_collection, print_z, copy, volume, lod_tolerance, lod_coarse);
                     else {
                         throw std::runtime_error("Unexpected extrusion_entity type in to_verts()");
                     }
@@ -88,10 +88,16 @@ void BackgroundSlicingProcess::process_fff()
 	    	//FIXME localize the messages
 	    	// Perform the final post-processing of the export path by applying the print statistics over the file name.
 	    	std::string export_path = m_fff_print->print_statistics().finalize_output_path(m_export_path);
-		    if (copy_file(m_temp_output_path, export_path) != 0)
-	    		throw std::runtime_error(_utf8(L("Copying of the temporary G-code to the output G-code failed. Maybe the SD card is write locked?")));
-	    	m_print->set_status(95, _utf8(L("Running post-processing scripts")));
-	    	run_post_process_scripts(export_path, m_fff_print->config());
+	    	if (post_process_streaming(m_fff_print->config())) {
+	    		// The post-processing scripts are fed with the temporary G-code and they write the output G-code.
+		    	m_print->set_status(95, _utf8(L("Running post-processing scripts")));
+	    		run_post_process_scripts(m_temp_output_path, export_path, m_fff_print->config());
+	    	} else {
+			    if (copy_file(m_temp_output_path, export_path) != 0)
+		    		throw std::runtime_error(_utf8(L("Copying of the temporary G-code to the output G-code failed. Maybe the SD card is write locked?")));
+		    	m_print->set_status(95, _utf8(L("Running post-processing scripts")));
+		    	run_post_process_scripts(export_path, m_fff_print->config());
+		    }
 	    	m_print->set_status(100, (boost::format(_utf8(L("G-code file exported to %1%"))) % export_path).str());
 	    } else if (! m_upload_job.empty()) {
 			prepare_upload();
@@ -413,10 +419,14 @@ void BackgroundSlicingProcess::prepare_upload()
 
 	if (m_print == m_fff_print) {
 		m_print->set_status(95, _utf8(L("Running post-processing scripts")));
-		if (copy_file(m_temp_output_path, source_path.string()) != 0) {
-			throw std::runtime_error(_utf8(L("Copying of the temporary G-code to the output G-code failed")));
+		if (post_process_streaming(m_fff_print->config()))
+			run_post_process_scripts(m_temp_output_path, source_path.string(), m_fff_print->config());
+		else {
+			if (copy_file(m_temp_output_path, source_path.string()) != 0) {
+				throw std::runtime_error(_utf8(L("Copying of the temporary G-code to the output G-code failed")));
+			}
+			run_post_process_scripts(source_path.string(), m_fff_print->config());
 		}
-		run_post_process_scripts(source_path.string(), m_fff_print->config());
 		m_upload_job.upload_data.upload_path = m_fff_print->print_statistics().finalize_output_path(m_upload_job.upload_data.upload_path.string());
     } else {
 		m_upload_job.upload_data.upload_path = m_sla_print->print_statistics().finalize_output_path(m_upload_job.upload_data.upload_path.string());
@@ -11,11 +11,8 @@
     #include <wx/rawbmp.h>
 #endif /* BROKEN_ALPHA */
 
-#define NANOSVG_IMPLEMENTATION
-#include "nanosvg/nanosvg.h"
-#define NANOSVGRAST_IMPLEMENTATION
-#include "nanosvg/nanosvgrast.h"
 #include "GUI_App.hpp"
+#include "../Utils/SVGRasterCache.hpp"
 
 namespace Slic3r { namespace GUI {
 
@@ -240,34 +237,12 @@ wxBitmap* BitmapCache::load_svg(const std::string &bitmap_name, unsigned target_
     if (it != m_map.end())
         return it->second;
 
-    NSVGimage *image = ::nsvgParseFromFile(Slic3r::var(bitmap_name + ".svg").c_str(), "px", 96.0f);
-    if (image == nullptr)
+    // Rasterized by nanosvg or loaded from the on-disk cache of the rasterized icons.
+    SVGRasterCache::Raster raster;
+    if (! wxGetApp().svg_raster_cache().get(bitmap_name, target_width, target_height, raster))
         return nullptr;
 
-    float svg_scale = target_height != 0 ? 
-                  (float)target_height / image->height  : target_width != 0 ?
-                  (float)target_width / image->width    : 1;
-
-    int   width    = (int)(svg_scale * image->width + 0.5f);
-    int   height   = (int)(svg_scale * image->height + 0.5f);
-    int   n_pixels = width * height;
-    if (n_pixels <= 0) {
-        ::nsvgDelete(image);
-        return nullptr;
-    }
-
-    NSVGrasterizer *rast = ::nsvgCreateRasterizer();
-    if (rast == nullptr) {
-        ::nsvgDelete(image);
-        return nullptr;
-    }
-
-    std::vector<unsigned char> data(n_pixels * 4, 0);
-    ::nsvgRasterize(rast, image, 0, 0, svg_scale, data.data(), width, height, width * 4);
-    ::nsvgDeleteRasterizer(rast);
-    ::nsvgDelete(image);
-
-    return this->insert_raw_rgba(bitmap_key, width, height, data.data(), scale, grayscale);
+    return this->insert_raw_rgba(bitmap_key, raster.width, raster.height, raster.rgba.data(), scale, grayscale);
 }
 
 wxBitmap BitmapCache::mksolid(size_t width, size_t height, unsigned char r, unsigned char g, unsigned char b, unsigned char transparency)
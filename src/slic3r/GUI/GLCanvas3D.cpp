@@ -81,6 +81,9 @@ static const size_t VERTEX_BUFFER_RESERVE_SIZE_SUM_MAX = 1024 * 1024 * 128 / 4;
 namespace Slic3r {
 namespace GUI {
 
+// 12.5um, which is well below the resolution of the sliced data.
+const double GLCanvas3D::ToolpathsLOD::Base_Tolerance = 0.0125;
+
 Size::Size()
     : m_width(0)
     , m_height(0)
@@ -1274,6 +1277,8 @@ unsigned int GLCanvas3D::get_volumes_count() const
 
 void GLCanvas3D::reset_volumes()
 {
+    m_toolpaths_lod.reset();
+
     if (!m_initialized)
         return;
 
@@ -1701,6 +1706,9 @@ std::vector<double> GLCanvas3D::get_current_print_zs(bool active_only) const
 void GLCanvas3D::set_toolpaths_range(double low, double high)
 {
     m_volumes.set_range(low, high);
+    m_toolpaths_lod.has_range  = true;
+    m_toolpaths_lod.range_low  = low;
+    m_toolpaths_lod.range_high = high;
 }
 
 std::vector<int> GLCanvas3D::load_object(const ModelObject& model_object, int obj_idx, std::vector<int> instance_idxs)
@@ -2144,6 +2152,7 @@ void GLCanvas3D::load_gcode_preview(const GCodePreviewData& preview_data, const
         if (m_volumes.empty())
         {
             m_gcode_preview_volume_index.reset();
+            m_toolpaths_lod.reset();
             
             _load_gcode_extrusion_paths(preview_data, tool_colors);
             _load_gcode_travel_paths(preview_data, tool_colors);
@@ -2223,6 +2232,10 @@ void GLCanvas3D::load_preview(const std::vector<std::string>& str_tool_colors, c
     // Release OpenGL data before generating new data.
     this->reset_volumes();
 
+    m_toolpaths_lod.loaded             = true;
+    m_toolpaths_lod.str_tool_colors    = str_tool_colors;
+    m_toolpaths_lod.color_print_values = color_print_values;
+
     _load_print_toolpaths();
     _load_wipe_tower_toolpaths(str_tool_colors);
     for (const PrintObject* object : print->objects())
@@ -2307,6 +2320,7 @@ void GLCanvas3D::on_idle(wxIdleEvent& evt)
     m_dirty |= m_main_toolbar.update_items_state();
     m_dirty |= m_undoredo_toolbar.update_items_state();
     m_dirty |= m_view_toolbar.update_items_state();
+    m_dirty |= _update_toolpaths_lod();
 
     if (!m_dirty)
         return;
@@ -4639,9 +4653,85 @@ void GLCanvas3D::_load_print_toolpaths()
     volume->indexed_vertex_array.finalize_geometry(m_initialized);
 }
 
+// Object and support layers of a print object with generated extrusions, ordered by print_z.
+static std::vector<const Layer*> toolpaths_layers(const PrintObject& print_object, bool& has_perimeters, bool& has_infill, bool& has_support)
+{
+    has_perimeters = print_object.is_step_done(posPerimeters);
+    has_infill = print_object.is_step_done(posInfill);
+    has_support = print_object.is_step_done(posSupportMaterial);
+
+    std::vector<const Layer*> layers;
+    {
+        size_t nlayers = 0;
+        if (has_perimeters || has_infill)
+            nlayers = print_object.layers().size();
+        if (has_support)
+            nlayers += print_object.support_layers().size();
+        layers.reserve(nlayers);
+    }
+    if (has_perimeters || has_infill)
+        for (const Layer *layer : print_object.layers())
+            layers.push_back(layer);
+    if (has_support)
+        for (const Layer *layer : print_object.support_layers())
+            layers.push_back(layer);
+    std::sort(layers.begin(), layers.end(), [](const Layer *l1, const Layer *l2) { return l1->print_z < l2->print_z; });
+    return layers;
+}
+
+// Last state change of the steps toolpaths_layers() depends on.
+static size_t toolpaths_timestamp(const PrintObject& print_object)
+{
+    size_t timestamp = 0;
+    for (PrintObjectStep step : { posSlice, posPerimeters, posInfill, posSupportMaterial })
+        timestamp = std::max(timestamp, print_object.step_state_with_timestamp(step).timestamp);
+    return timestamp;
+}
+
 void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, const std::vector<std::string>& str_tool_colors, const std::vector<double>& color_print_values)
 {
-    std::vector<float> tool_colors = _parse_colors(str_tool_colors);
+    bool has_perimeters, has_infill, has_support;
+    std::vector<const Layer*> layers = toolpaths_layers(print_object, has_perimeters, has_infill, has_support);
+    if (layers.empty())
+        return;
+
+    // Split the layers into spans, which are generated in parallel and which may later be regenerated
+    // with a different level of detail independently.
+    // Supports and perimeters may stick out of the object a bit.
+    BoundingBox  object_bbox_scaled = print_object.bounding_box();
+    BoundingBoxf object_bbox(unscale(object_bbox_scaled.min), unscale(object_bbox_scaled.max));
+    object_bbox.offset(5.);
+    const size_t layers_per_span = std::min<size_t>(32, std::max<size_t>(1, layers.size() / 16));
+    const int    zoom_level      = _toolpaths_lod_level();
+    const size_t timestamp       = toolpaths_timestamp(print_object);
+    std::vector<size_t> span_ids;
+    for (size_t layer_begin = 0; layer_begin < layers.size(); layer_begin += layers_per_span) {
+        ToolpathsLOD::Span span;
+        span.object      = &print_object;
+        span.layer_begin = layer_begin;
+        span.layer_end   = std::min(layer_begin + layers_per_span, layers.size());
+        span.timestamp   = timestamp;
+        double z_min     = layers[span.layer_begin]->print_z - layers[span.layer_begin]->height;
+        double z_max     = layers[span.layer_end - 1]->print_z;
+        bool   visible   = false;
+        for (const Point &copy : print_object.copies()) {
+            Vec2d shift = unscale(copy);
+            span.boxes.emplace_back(Vec3d(object_bbox.min(0) + shift(0), object_bbox.min(1) + shift(1), z_min),
+                                    Vec3d(object_bbox.max(0) + shift(0), object_bbox.max(1) + shift(1), z_max));
+            visible |= _is_in_view_frustum(span.boxes.back());
+        }
+        span.level = visible ? zoom_level : ToolpathsLOD::Max_Level;
+        span_ids.emplace_back(m_toolpaths_lod.spans.size());
+        m_toolpaths_lod.spans.emplace_back(std::move(span));
+    }
+
+    _load_toolpaths_lod_spans(print_object, span_ids);
+}
+
+void GLCanvas3D::_load_toolpaths_lod_spans(const PrintObject& print_object, const std::vector<size_t>& span_ids)
+{
+    std::vector<float> tool_colors = _parse_colors(m_toolpaths_lod.str_tool_colors);
+    const std::vector<double> &color_print_values = m_toolpaths_lod.color_print_values;
 
     struct Ctxt
     {
@@ -4670,41 +4760,22 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
         }
     } ctxt;
 
-    ctxt.has_perimeters = print_object.is_step_done(posPerimeters);
-    ctxt.has_infill = print_object.is_step_done(posInfill);
-    ctxt.has_support = print_object.is_step_done(posSupportMaterial);
+    ctxt.layers = toolpaths_layers(print_object, ctxt.has_perimeters, ctxt.has_infill, ctxt.has_support);
     ctxt.tool_colors = tool_colors.empty() ? nullptr : &tool_colors;
     ctxt.color_print_values = color_print_values.empty() ? nullptr : &color_print_values;
 
     ctxt.shifted_copies = &print_object.copies();
 
-    // order layers by print_z
-    {
-        size_t nlayers = 0;
-        if (ctxt.has_perimeters || ctxt.has_infill)
-            nlayers = print_object.layers().size();
-        if (ctxt.has_support)
-            nlayers += print_object.support_layers().size();
-        ctxt.layers.reserve(nlayers);
-    }
-    if (ctxt.has_perimeters || ctxt.has_infill)
-        for (const Layer *layer : print_object.layers())
-            ctxt.layers.push_back(layer);
-    if (ctxt.has_support)
-        for (const Layer *layer : print_object.support_layers())
-            ctxt.layers.push_back(layer);
-    std::sort(ctxt.layers.begin(), ctxt.layers.end(), [](const Layer *l1, const Layer *l2) { return l1->print_z < l2->print_z; });
-
     // Maximum size of an allocation block: 32MB / sizeof(float)
     BOOST_LOG_TRIVIAL(debug) << "Loading print object toolpaths in parallel - start" << m_volumes.log_memory_info() << log_memory_info();
 
-    //FIXME Improve the heuristics for a grain size.
-    size_t          grain_size = std::max(ctxt.layers.size() / 16, size_t(1));
     tbb::spin_mutex new_volume_mutex;
-    auto            new_volume = [this, &new_volume_mutex](const float *color) -> GLVolume* {
+    auto            new_volume = [this, &new_volume_mutex](ToolpathsLOD::Span &span, const float *color) -> GLVolume* {
     	// Allocate the volume before locking.
 		GLVolume *volume = new GLVolume(color);
 		volume->is_extrusion_path = true;
+		// The span is only accessed by a single thread.
+		span.volumes.emplace_back(volume);
     	tbb::spin_mutex::scoped_lock lock;
     	// Lock by ROII, so if the emplace_back() fails, the lock will be released.
         lock.acquire(new_volume_mutex);
@@ -4713,9 +4784,15 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
         return volume;
     };
     const size_t    volumes_cnt_initial = m_volumes.volumes.size();
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, ctxt.layers.size(), grain_size),
-        [&ctxt, &new_volume](const tbb::blocked_range<size_t>& range) {
+    // One span per task, the spans are generated with the level of detail stored in the span.
+    tbb::parallel_for(size_t(0), span_ids.size(),
+        [this, &ctxt, &new_volume, &span_ids](size_t idx_span) {
+        ToolpathsLOD::Span &span          = m_toolpaths_lod.spans[span_ids[idx_span]];
+        const double        lod_tolerance = scale_(ToolpathsLOD::tolerance(span.level));
+        const bool          lod_coarse    = ToolpathsLOD::coarse(span.level);
+        // The callers drop the spans of an object, which changed its state since the spans were created.
+        assert(span.layer_end <= ctxt.layers.size());
+        const tbb::blocked_range<size_t> range(std::min(span.layer_begin, ctxt.layers.size()), std::min(span.layer_end, ctxt.layers.size()));
         GLVolumePtrs 		vols;
         std::vector<size_t>	color_print_layer_to_glvolume;
         auto                volume = [&ctxt, &vols, &color_print_layer_to_glvolume, &range](size_t layer_idx, int extruder, int feature) -> GLVolume& {
@@ -4735,17 +4812,17 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
 	        	int idx_tool = (int)ctxt.color_print_color_idx_by_layer_idx(idx_layer);
 	        	if (color_print_tool_to_glvolume[idx_tool] == -1) {
 	        		color_print_tool_to_glvolume[idx_tool] = (int)vols.size();
-	        		vols.emplace_back(new_volume(ctxt.color_tool(idx_tool)));
+	        		vols.emplace_back(new_volume(span, ctxt.color_tool(idx_tool)));
 	        	}
 	        	color_print_layer_to_glvolume.emplace_back(color_print_tool_to_glvolume[idx_tool]);
 	        }
         }
         else if (ctxt.color_by_tool()) {
             for (size_t i = 0; i < ctxt.number_tools(); ++i)
-                vols.emplace_back(new_volume(ctxt.color_tool(i)));
+                vols.emplace_back(new_volume(span, ctxt.color_tool(i)));
         }
         else
-            vols = { new_volume(ctxt.color_perimeters()), new_volume(ctxt.color_infill()), new_volume(ctxt.color_support()) };
+            vols = { new_volume(span, ctxt.color_perimeters()), new_volume(span, ctxt.color_infill()), new_volume(span, ctxt.color_support()) };
         for (GLVolume *vol : vols)
 			// Reserving number of vertices (3x position + 3x color)
         	vol->indexed_vertex_array.reserve(VERTEX_BUFFER_RESERVE_SIZE / 6);
@@ -4761,7 +4838,7 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
                 for (const LayerRegion *layerm : layer->regions()) {
                     if (ctxt.has_perimeters)
                         _3DScene::extrusionentity_to_verts(layerm->perimeters, float(layer->print_z), copy,
-                        	volume(idx_layer, layerm->region()->config().perimeter_extruder.value, 0));
+                        	volume(idx_layer, layerm->region()->config().perimeter_extruder.value, 0), lod_tolerance, lod_coarse);
                     if (ctxt.has_infill) {
                         for (const ExtrusionEntity *ee : layerm->fills.entities) {
                             // fill represents infill extrusions of a single island.
@@ -4772,7 +4849,7 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
 		                                is_solid_infill(fill->entities.front()->role()) ?
 			                                layerm->region()->config().solid_infill_extruder :
 			                                layerm->region()->config().infill_extruder,
-		                                1));
+		                                1), lod_tolerance, lod_coarse);
                         }
                     }
                 }
@@ -4785,7 +4862,7 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
 		                            (extrusion_entity->role() == erSupportMaterial) ?
 			                            support_layer->object()->config().support_material_extruder :
 			                            support_layer->object()->config().support_material_interface_extruder,
-		                            2));
+		                            2), lod_tolerance, lod_coarse);
                     }
                 }
             }
@@ -4793,7 +4870,7 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
 	        for (size_t i = 0; i < vols.size(); ++i) {
 	            GLVolume &vol = *vols[i];
 	            if (vol.indexed_vertex_array.vertices_and_normals_interleaved.size() > MAX_VERTEX_BUFFER_SIZE) {
-	                vols[i] = new_volume(vol.color);
+	                vols[i] = new_volume(span, vol.color);
 	                reserve_new_volume_finalize_old_volume(*vols[i], vol, false);
 	            }
 	        }
@@ -4806,16 +4883,122 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
 
     BOOST_LOG_TRIVIAL(debug) << "Loading print object toolpaths in parallel - finalizing results" << m_volumes.log_memory_info() << log_memory_info();
     // Remove empty volumes from the newly added volumes.
-    m_volumes.volumes.erase(
-        std::remove_if(m_volumes.volumes.begin() + volumes_cnt_initial, m_volumes.volumes.end(),
-        [](const GLVolume *volume) { return volume->empty(); }),
-        m_volumes.volumes.end());
+    auto volume_empty = [](const GLVolume *volume) { return volume->empty(); };
+    for (size_t span_id : span_ids) {
+        GLVolumePtrs &volumes = m_toolpaths_lod.spans[span_id].volumes;
+        volumes.erase(std::remove_if(volumes.begin(), volumes.end(), volume_empty), volumes.end());
+    }
+    for (auto it = m_volumes.volumes.begin() + volumes_cnt_initial; it != m_volumes.volumes.end(); ++ it)
+        if ((*it)->empty()) {
+            delete *it;
+            *it = nullptr;
+        }
+    m_volumes.volumes.erase(std::remove(m_volumes.volumes.begin() + volumes_cnt_initial, m_volumes.volumes.end(), nullptr), m_volumes.volumes.end());
     for (size_t i = volumes_cnt_initial; i < m_volumes.volumes.size(); ++i)
         m_volumes.volumes[i]->indexed_vertex_array.finalize_geometry(m_initialized);
 
     BOOST_LOG_TRIVIAL(debug) << "Loading print object toolpaths in parallel - end" << m_volumes.log_memory_info() << log_memory_info();
 }
 
+int GLCanvas3D::_toolpaths_lod_level() const
+{
+    // Zoom is the number of pixels per millimeter. Keep the simplification error below half a pixel.
+    double pixel_size = 1. / std::max(m_camera.get_zoom(), EPSILON);
+    double ratio      = 0.5 * pixel_size / ToolpathsLOD::Base_Tolerance;
+    return (ratio < 1.) ? 0 : std::min(int(ToolpathsLOD::Max_Level), 1 + int(std::floor(std::log2(ratio))));
+}
+
+bool GLCanvas3D::_is_in_view_frustum(const BoundingBoxf3& box) const
+{
+    const std::array<int, 4>& viewport = m_camera.get_viewport();
+    if (viewport[2] <= 0 || viewport[3] <= 0)
+        // The camera has not been set up by a render() call yet.
+        return true;
+    // Use the full 4x4 matrices, the projection is not an affine transformation.
+    Eigen::Matrix4d world_to_clip = m_camera.get_projection_matrix().matrix() * m_camera.get_view_matrix().matrix();
+    BoundingBoxf    ndc_box;
+    for (unsigned int i = 0; i < 8; ++ i) {
+        Vec3d           corner((i & 1) ? box.max(0) : box.min(0), (i & 2) ? box.max(1) : box.min(1), (i & 4) ? box.max(2) : box.min(2));
+        Eigen::Vector4d clip = world_to_clip * Eigen::Vector4d(corner(0), corner(1), corner(2), 1.);
+        if (clip(3) <= 0.)
+            // Behind the camera, don't bother clipping.
+            return true;
+        ndc_box.merge(Vec2d(clip(0) / clip(3), clip(1) / clip(3)));
+    }
+    return ndc_box.max(0) >= -1. && ndc_box.min(0) <= 1. && ndc_box.max(1) >= -1. && ndc_box.min(1) <= 1.;
+}
+
+bool GLCanvas3D::_update_toolpaths_lod()
+{
+    const Print *print = this->fff_print();
+    if (! m_toolpaths_lod.loaded || print == nullptr || m_mouse.dragging)
+        return false;
+
+    // Spans to be regenerated and their new levels, grouped by print object.
+    std::vector<std::pair<const PrintObject*, std::vector<std::pair<size_t, int>>>> dirty;
+    const int zoom_level = _toolpaths_lod_level();
+    for (size_t span_id = 0; span_id < m_toolpaths_lod.spans.size(); ++ span_id) {
+        const ToolpathsLOD::Span &span = m_toolpaths_lod.spans[span_id];
+        // Hysteresis: The level was chosen for an error below half a pixel. Refine once the error exceeds a pixel,
+        // coarsen once the level is finer than needed by more than one step. Don't coarsen the spans leaving the view frustum,
+        // so that panning back and forth does not regenerate them.
+        int level = span.level;
+        if (span.level > zoom_level + 1) {
+            if (std::any_of(span.boxes.begin(), span.boxes.end(), [this](const BoundingBoxf3 &box){ return _is_in_view_frustum(box); }))
+                level = zoom_level;
+        } else if (span.level + 1 < zoom_level)
+            level = zoom_level;
+        if (level != span.level) {
+            if (dirty.empty() || dirty.back().first != span.object)
+                dirty.emplace_back(span.object, std::vector<std::pair<size_t, int>>());
+            dirty.back().second.emplace_back(span_id, level);
+        }
+    }
+    if (dirty.empty() || ! _set_current())
+        return false;
+
+    BOOST_LOG_TRIVIAL(debug) << "Updating the level of detail of the toolpaths preview";
+    bool updated = false;
+    for (const std::pair<const PrintObject*, std::vector<std::pair<size_t, int>>> &object_spans : dirty) {
+        const PrintObject *object = object_spans.first;
+        // The print may have been invalidated since the toolpaths were loaded, before the preview was reloaded.
+        // The layer ranges of the spans are only valid for the state of the object they were created with.
+        if (std::find(print->objects().begin(), print->objects().end(), object) == print->objects().end() ||
+            ! (object->is_step_done(posPerimeters) || object->is_step_done(posSupportMaterial)) ||
+            m_toolpaths_lod.spans[object_spans.second.front().first].timestamp != toolpaths_timestamp(*object))
+            continue;
+        // Release the volumes of the dirty spans. Their new level is only stored now, as they are regenerated.
+        std::vector<size_t>    span_ids;
+        std::vector<GLVolume*> released;
+        for (const std::pair<size_t, int> &span_level : object_spans.second) {
+            ToolpathsLOD::Span &span = m_toolpaths_lod.spans[span_level.first];
+            released.insert(released.end(), span.volumes.begin(), span.volumes.end());
+            span.volumes.clear();
+            span.level = span_level.second;
+            span_ids.emplace_back(span_level.first);
+        }
+        std::sort(released.begin(), released.end());
+        auto is_released = [&released](const GLVolume *volume) { return std::binary_search(released.begin(), released.end(), volume); };
+        // The regenerated volumes will be placed where the first released volume was, so that the order of the volumes is maintained.
+        size_t volumes_insert_pos = std::find_if(m_volumes.volumes.begin(), m_volumes.volumes.end(), is_released) - m_volumes.volumes.begin();
+        m_volumes.volumes.erase(std::remove_if(m_volumes.volumes.begin(), m_volumes.volumes.end(), is_released), m_volumes.volumes.end());
+        volumes_insert_pos = std::min(volumes_insert_pos, m_volumes.volumes.size());
+        for (GLVolume *volume : released)
+            delete volume;
+        // Regenerate them with the new level of detail.
+        size_t volumes_cnt_initial = m_volumes.volumes.size();
+        _load_toolpaths_lod_spans(*object, span_ids);
+        if (m_toolpaths_lod.has_range)
+            for (size_t i = volumes_cnt_initial; i < m_volumes.volumes.size(); ++ i)
+                m_volumes.volumes[i]->set_range(m_toolpaths_lod.range_low, m_toolpaths_lod.range_high);
+        std::rotate(m_volumes.volumes.begin() + volumes_insert_pos, m_volumes.volumes.begin() + volumes_cnt_initial, m_volumes.volumes.end());
+        updated = true;
+    }
+    if (updated)
+        _update_toolpath_volumes_outside_state();
+    return updated;
+}
+
 void GLCanvas3D::_load_wipe_tower_toolpaths(const std::vector<std::string>& str_tool_colors)
 {
     const Print *print = this->fff_print();
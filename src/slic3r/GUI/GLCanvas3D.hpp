@@ -159,6 +159,56 @@ public:
         void reset() { first_volumes.clear(); }
     };
 
+    // Level of detail of the toolpaths preview generated by load_preview().
+    // Level 0 is the full resolution, each next level doubles the tolerance of the polyline simplification.
+    // The layers of each print object are split into spans, each span is stored in GLVolumes of its own.
+    // The level is chosen per span, so that the simplification error stays below half a pixel on the screen.
+    // Spans outside of the view frustum are generated with the coarsest level.
+    // Once the camera moves, only the spans, which require a finer level by more than one step
+    // or a coarser level by more than one step, are regenerated on idle, outside of the render pass.
+    struct ToolpathsLOD
+    {
+        static const int Max_Level = 6;
+        // Tolerance (unscaled) of the finest simplified level.
+        static const double Base_Tolerance;
+
+        // From this level on, a pixel is at least 0.2mm wide, the extrusions cover just a few pixels on the screen
+        // and they are generated with the coarse geometry of _3DScene::thick_lines_to_verts_coarse().
+        static const int Coarse_Level = 4;
+
+        static double tolerance(int level) { return (level <= 0) ? 0. : Base_Tolerance * double(1 << (level - 1)); }
+        static bool   coarse(int level) { return level >= Coarse_Level; }
+
+        struct Span
+        {
+            const PrintObject          *object { nullptr };
+            // Range of layers in the print_z ordered list of the object and support layers of the object.
+            size_t                      layer_begin { 0 };
+            size_t                      layer_end { 0 };
+            // Last state change of the steps the layers were collected from. If the object changes its state
+            // (for example it is sliced again), the layer range is no longer valid and the span is not regenerated.
+            size_t                      timestamp { 0 };
+            // Bounding box of the span for each copy of the object.
+            std::vector<BoundingBoxf3>  boxes;
+            // Level of detail the span was generated with.
+            int                         level { 0 };
+            // Volumes of m_volumes owned by this span.
+            GLVolumePtrs                volumes;
+        };
+
+        // Were the toolpaths generated by load_preview()?
+        bool                     loaded { false };
+        std::vector<Span>        spans;
+        // Parameters of the last load_preview() call and the last layer range, to be able to regenerate the toolpaths.
+        std::vector<std::string> str_tool_colors;
+        std::vector<double>      color_print_values;
+        bool                     has_range { false };
+        double                   range_low { 0. };
+        double                   range_high { 0. };
+
+        void reset() { loaded = false; spans.clear(); has_range = false; }
+    };
+
 private:
     class LayersEditing
     {
@@ -453,6 +503,7 @@ private:
     bool m_reload_delayed;
 
     GCodePreviewVolumeIndex m_gcode_preview_volume_index;
+    ToolpathsLOD m_toolpaths_lod;
 
 #if ENABLE_RENDER_PICKING_PASS
     bool m_show_picking_texture;
@@ -715,6 +766,15 @@ private:
                                       const std::vector<double>& color_print_values);
     // Create 3D thick extrusion lines for wipe tower extrusions
     void _load_wipe_tower_toolpaths(const std::vector<std::string>& str_tool_colors);
+    // Generates the toolpaths of the given spans of m_toolpaths_lod, all of them belonging to print_object.
+    void _load_toolpaths_lod_spans(const PrintObject& print_object, const std::vector<size_t>& span_ids);
+    // Returns the level of detail needed to render the toolpaths with a sub-pixel accuracy at the current zoom.
+    int _toolpaths_lod_level() const;
+    // Returns false if the box is for sure outside of the view frustum of the current camera.
+    bool _is_in_view_frustum(const BoundingBoxf3& box) const;
+    // Regenerates the spans of the toolpaths, for which the current camera requires a different level of detail.
+    // Called on idle. Returns true if any span was regenerated.
+    bool _update_toolpaths_lod();
 
     // generates gcode extrusion paths geometry
     void _load_gcode_extrusion_paths(const GCodePreviewData& preview_data, const std::vector<float>& tool_colors);
@@ -14,9 +14,6 @@
 #include <algorithm>
 #include <thread>
 
-#define STB_DXT_IMPLEMENTATION
-#include "stb_dxt/stb_dxt.h"
-
 #include "nanosvg/nanosvg.h"
 #include "nanosvg/nanosvgrast.h"
 
@@ -25,6 +22,14 @@
 namespace Slic3r {
 namespace GUI {
 
+// The compressed levels of the textures are cached on disk, so that the next start of the application
+// sends them to gpu without generating and compressing them again.
+static const MipmapCache& mipmap_cache()
+{
+    static MipmapCache cache(data_dir().empty() ? std::string() : (boost::filesystem::path(data_dir()) / "cache" / "textures").string());
+    return cache;
+}
+
 void GLTexture::Compressor::reset()
 {
 	if (m_thread.joinable()) {
@@ -34,6 +39,7 @@ void GLTexture::Compressor::reset()
 	    m_num_levels_compressed = 0;
 	    m_abort_compressing = false;
 	}
+	m_cache_writer.abort();
 	assert(m_levels.empty());
 	assert(m_abort_compressing == false);
 	assert(m_num_levels_compressed == 0);
@@ -96,8 +102,6 @@ void GLTexture::Compressor::send_compressed_data_to_gpu()
 
 void GLTexture::Compressor::compress()
 {
-    // reference: https://github.com/Cyan4973/RygsDXTc
-
     assert(m_num_levels_compressed == 0);
     assert(m_abort_compressing == false);
 
@@ -106,17 +110,24 @@ void GLTexture::Compressor::compress()
         if (m_abort_compressing)
             break;
 
-        // stb_dxt library, despite claiming that the needed size of the destination buffer is equal to (source buffer size)/4,
-        // crashes if doing so, so we start with twice the required size
-        level.compressed_data = std::vector<unsigned char>(level.w * level.h * 2, 0);
-        int compressed_size = 0;
-        rygCompress(level.compressed_data.data(), level.src_data.data(), level.w, level.h, 1, compressed_size);
-        level.compressed_data.resize(compressed_size);
-
+        // the blocks of the level are compressed in parallel
+        MipmapLevel src;
+        MipmapLevel dst;
+        src.w = level.w;
+        src.h = level.h;
         // we are done with the source data, we can discard it
-        level.src_data.clear();
+        src.data = std::move(level.src_data);
+        compress_dxt5(src, dst);
+        if (m_cache_writer.valid())
+            m_cache_writer.append(dst);
+        level.compressed_data = std::move(dst.data);
         ++ m_num_levels_compressed;
     }
+
+    if (m_num_levels_compressed == (unsigned int)m_levels.size())
+        m_cache_writer.commit();
+    else
+        m_cache_writer.abort();
 }
 
 GLTexture::Quad_UVs GLTexture::FullTextureUVs = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f } };
@@ -359,6 +370,17 @@ bool GLTexture::load_from_png(const std::string& filename, bool use_mipmaps, ECo
 {
     bool compression_enabled = (compression_type != None) && GLEW_EXT_texture_compression_s3tc;
 
+    uint64_t cache_key = 0;
+    if (compression_enabled && (compression_type == MultiThreaded))
+    {
+        cache_key = MipmapCache::key(filename, (uint32_t)GLCanvas3DManager::get_gl_info().get_max_tex_size(), { 0, (uint32_t)use_mipmaps });
+        if (load_from_cache(cache_key, apply_anisotropy))
+        {
+            m_source = filename;
+            return true;
+        }
+    }
+
     // Load a PNG with an alpha channel.
     wxImage image;
     if (!image.LoadFile(wxString::FromUTF8(filename.c_str()), wxBITMAP_TYPE_PNG))
@@ -411,7 +433,11 @@ bool GLTexture::load_from_png(const std::string& filename, bool use_mipmaps, ECo
 
     unsigned char* img_alpha = image.GetAlpha();
 
-    std::vector<unsigned char> data(n_pixels * 4, 0);
+    std::vector<MipmapLevel> levels(1);
+    levels.front().w = (unsigned int)m_width;
+    levels.front().h = (unsigned int)m_height;
+    std::vector<unsigned char>& data = levels.front().data;
+    data.assign(n_pixels * 4, 0);
     for (int i = 0; i < n_pixels; ++i)
     {
         int data_id = i * 4;
@@ -422,6 +448,17 @@ bool GLTexture::load_from_png(const std::string& filename, bool use_mipmaps, ECo
         data[data_id + 3] = (img_alpha != nullptr) ? img_alpha[i] : 255;
     }
 
+    if (use_mipmaps)
+    {
+        // we manually generate mipmaps because glGenerateMipmap() function is not reliable on all graphics cards
+        // we do not need to generate all levels down to 1x1
+        while (mipmap_has_next(levels.back().w, levels.back().h))
+        {
+            levels.emplace_back();
+            downscale_mipmap(levels[levels.size() - 2], levels.back());
+        }
+    }
+
     // sends data to gpu
     glsafe(::glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
     glsafe(::glGenTextures(1, &m_id));
@@ -434,72 +471,30 @@ bool GLTexture::load_from_png(const std::string& filename, bool use_mipmaps, ECo
             glsafe(::glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_anisotropy));
     }
 
-    if (compression_enabled)
+    for (GLint level = 0; level < (GLint)levels.size(); ++level)
     {
-        if (compression_type == SingleThreaded)
-            glsafe(::glTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
-        else
+        MipmapLevel& lod = levels[level];
+        if (compression_enabled)
         {
-            // initializes the texture on GPU 
-            glsafe(::glTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
-            // and send the uncompressed data to the compressor
-            m_compressor.add_level((unsigned int)m_width, (unsigned int)m_height, data);
+            if (compression_type == SingleThreaded)
+                glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod.w, (GLsizei)lod.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)lod.data.data()));
+            else
+            {
+                // initializes the texture on GPU 
+                glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod.w, (GLsizei)lod.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
+                // and send the uncompressed data to the compressor
+                m_compressor.add_level(lod.w, lod.h, std::move(lod.data));
+            }
         }
+        else
+            glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, (GLsizei)lod.w, (GLsizei)lod.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)lod.data.data()));
     }
-    else
-        glsafe(::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
 
     if (use_mipmaps)
     {
-        // we manually generate mipmaps because glGenerateMipmap() function is not reliable on all graphics cards
-        int lod_w = m_width;
-        int lod_h = m_height;
-        GLint level = 0;
-        // we do not need to generate all levels down to 1x1
-        while ((lod_w > 16) || (lod_h > 16))
-        {
-            ++level;
-
-            lod_w = std::max(lod_w / 2, 1);
-            lod_h = std::max(lod_h / 2, 1);
-            n_pixels = lod_w * lod_h;
-
-            image = image.ResampleBicubic(lod_w, lod_h);
-
-            data.resize(n_pixels * 4);
-
-            img_rgb = image.GetData();
-            img_alpha = image.GetAlpha();
-
-            for (int i = 0; i < n_pixels; ++i)
-            {
-                int data_id = i * 4;
-                int img_id = i * 3;
-                data[data_id + 0] = img_rgb[img_id + 0];
-                data[data_id + 1] = img_rgb[img_id + 1];
-                data[data_id + 2] = img_rgb[img_id + 2];
-                data[data_id + 3] = (img_alpha != nullptr) ? img_alpha[i] : 255;
-            }
-
-            if (compression_enabled)
-            {
-                if (compression_type == SingleThreaded)
-                    glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
-                else
-                {
-                    // initializes the texture on GPU 
-                    glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod_w, (GLsizei)lod_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
-                    // and send the uncompressed data to the compressor
-                    m_compressor.add_level((unsigned int)lod_w, (unsigned int)lod_h, data);
-                }
-            }
-            else
-                glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, (GLsizei)lod_w, (GLsizei)lod_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
-        }
-
         if (!compression_enabled)
         {
-            glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level));
+            glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1));
             glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
         }
     }
@@ -516,8 +511,11 @@ bool GLTexture::load_from_png(const std::string& filename, bool use_mipmaps, ECo
     m_source = filename;
 
     if (compression_enabled && (compression_type == MultiThreaded))
-        // start asynchronous compression
+    {
+        // start asynchronous compression, the compressed levels will be cached
+        m_compressor.store_to_cache(mipmap_cache(), cache_key);
         m_compressor.start_compressing();
+    }
 
     return true;
 }
@@ -526,6 +524,17 @@ bool GLTexture::load_from_svg(const std::string& filename, bool use_mipmaps, boo
 {
     bool compression_enabled = compress && GLEW_EXT_texture_compression_s3tc;
 
+    uint64_t cache_key = 0;
+    if (compression_enabled)
+    {
+        cache_key = MipmapCache::key(filename, (uint32_t)GLCanvas3DManager::get_gl_info().get_max_tex_size(), { 1, (uint32_t)use_mipmaps, max_size_px });
+        if (load_from_cache(cache_key, apply_anisotropy))
+        {
+            m_source = filename;
+            return true;
+        }
+    }
+
     NSVGimage* image = nsvgParseFromFile(filename.c_str(), "px", 96.0f);
     if (image == nullptr)
     {
@@ -560,17 +569,28 @@ bool GLTexture::load_from_svg(const std::string& filename, bool use_mipmaps, boo
         return false;
     }
 
-    NSVGrasterizer* rast = nsvgCreateRasterizer();
-    if (rast == nullptr)
+    // rasterizes all the levels, each of them in parallel strips
+    std::vector<MipmapLevel> levels(1);
+    levels.front().w = (unsigned int)m_width;
+    levels.front().h = (unsigned int)m_height;
+    rasterize_svg(image, scale, levels.front().w, levels.front().h, levels.front().data);
+
+    if (use_mipmaps)
     {
-        nsvgDelete(image);
-        reset();
-        return false;
+        // we manually generate mipmaps because glGenerateMipmap() function is not reliable on all graphics cards
+        // we do not need to generate all levels down to 1x1
+        while (mipmap_has_next(levels.back().w, levels.back().h))
+        {
+            MipmapLevel lod;
+            lod.w = mipmap_next_size(levels.back().w);
+            lod.h = mipmap_next_size(levels.back().h);
+            scale /= 2.0f;
+            rasterize_svg(image, scale, lod.w, lod.h, lod.data);
+            levels.emplace_back(std::move(lod));
+        }
     }
 
-    // creates the temporary buffer only once, with max size, and reuse it for all the levels, if generating mipmaps
-    std::vector<unsigned char> data(n_pixels * 4, 0);
-    nsvgRasterize(rast, image, 0, 0, scale, data.data(), m_width, m_height, m_width * 4);
+    nsvgDelete(image);
 
     // sends data to gpu
     glsafe(::glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
@@ -584,48 +604,25 @@ bool GLTexture::load_from_svg(const std::string& filename, bool use_mipmaps, boo
             glsafe(::glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_anisotropy));
     }
 
-    if (compression_enabled)
+    for (GLint level = 0; level < (GLint)levels.size(); ++level)
     {
-        // initializes the texture on GPU 
-        glsafe(::glTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
-        // and send the uncompressed data to the compressor
-        m_compressor.add_level((unsigned int)m_width, (unsigned int)m_height, data);
+        MipmapLevel& lod = levels[level];
+        if (compression_enabled)
+        {
+            // initializes the texture on GPU 
+            glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod.w, (GLsizei)lod.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
+            // and send the uncompressed data to the compressor
+            m_compressor.add_level(lod.w, lod.h, std::move(lod.data));
+        }
+        else
+            glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, (GLsizei)lod.w, (GLsizei)lod.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)lod.data.data()));
     }
-    else
-        glsafe(::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)m_width, (GLsizei)m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
 
     if (use_mipmaps)
     {
-        // we manually generate mipmaps because glGenerateMipmap() function is not reliable on all graphics cards
-        int lod_w = m_width;
-        int lod_h = m_height;
-        GLint level = 0;
-        // we do not need to generate all levels down to 1x1
-        while ((lod_w > 16) || (lod_h > 16))
-        {
-            ++level;
-
-            lod_w = std::max(lod_w / 2, 1);
-            lod_h = std::max(lod_h / 2, 1);
-            scale /= 2.0f;
-
-            data.resize(lod_w * lod_h * 4);
-
-            nsvgRasterize(rast, image, 0, 0, scale, data.data(), lod_w, lod_h, lod_w * 4);
-            if (compression_enabled)
-            {
-                // initializes the texture on GPU 
-                glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod_w, (GLsizei)lod_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0));
-                // and send the uncompressed data to the compressor
-                m_compressor.add_level((unsigned int)lod_w, (unsigned int)lod_h, data);
-            }
-            else
-                glsafe(::glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, (GLsizei)lod_w, (GLsizei)lod_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)data.data()));
-        }
-
         if (!compression_enabled)
         {
-            glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level));
+            glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1));
             glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
         }
     }
@@ -642,11 +639,47 @@ bool GLTexture::load_from_svg(const std::string& filename, bool use_mipmaps, boo
     m_source = filename;
 
     if (compression_enabled)
-        // start asynchronous compression
+    {
+        // start asynchronous compression, the compressed levels will be cached
+        m_compressor.store_to_cache(mipmap_cache(), cache_key);
         m_compressor.start_compressing();
+    }
 
-    nsvgDeleteRasterizer(rast);
-    nsvgDelete(image);
+    return true;
+}
+
+bool GLTexture::load_from_cache(uint64_t cache_key, bool apply_anisotropy)
+{
+    std::vector<MipmapLevel> levels;
+    if (!mipmap_cache().load(cache_key, levels))
+        return false;
+
+    m_width = (int)levels.front().w;
+    m_height = (int)levels.front().h;
+
+    // sends the already compressed data to gpu
+    glsafe(::glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    glsafe(::glGenTextures(1, &m_id));
+    glsafe(::glBindTexture(GL_TEXTURE_2D, m_id));
+
+    if (apply_anisotropy)
+    {
+        GLfloat max_anisotropy = GLCanvas3DManager::get_gl_info().get_max_anisotropy();
+        if (max_anisotropy > 1.0f)
+            glsafe(::glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_anisotropy));
+    }
+
+    for (GLint level = 0; level < (GLint)levels.size(); ++level)
+    {
+        const MipmapLevel& lod = levels[level];
+        glsafe(::glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, (GLsizei)lod.w, (GLsizei)lod.h, 0, (GLsizei)lod.data.size(), (const GLvoid*)lod.data.data()));
+    }
+
+    glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1));
+    glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (levels.size() > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR));
+    glsafe(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+
+    glsafe(::glBindTexture(GL_TEXTURE_2D, 0));
 
     return true;
 }
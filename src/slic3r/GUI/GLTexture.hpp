@@ -6,6 +6,8 @@
 #include <vector>
 #include <thread>
 
+#include "../Utils/Mipmaps.hpp"
+
 class wxImage;
 
 namespace Slic3r {
@@ -23,7 +25,7 @@ namespace GUI {
                 std::vector<unsigned char> compressed_data;
                 bool sent_to_gpu;
 
-                Level(unsigned int w, unsigned int h, const std::vector<unsigned char>& data) : w(w), h(h), src_data(data), sent_to_gpu(false) {}
+                Level(unsigned int w, unsigned int h, std::vector<unsigned char>&& data) : w(w), h(h), src_data(std::move(data)), sent_to_gpu(false) {}
             };
 
             GLTexture& m_texture;
@@ -35,6 +37,8 @@ namespace GUI {
             // How many levels were compressed since the start of the background processing thread?
             // This atomic also works as a memory barrier for synchronizing results of the worker thread with the calling thread.
             std::atomic<unsigned int> m_num_levels_compressed;
+            // Stores the compressed levels into the on-disk cache, if valid. Accessed by the worker thread only while it is running.
+            MipmapCache::Writer m_cache_writer;
 
         public:
             explicit Compressor(GLTexture& texture) : m_texture(texture), m_abort_compressing(false), m_num_levels_compressed(0) {}
@@ -42,7 +46,9 @@ namespace GUI {
 
             void reset();
 
-            void add_level(unsigned int w, unsigned int h, const std::vector<unsigned char>& data) { m_levels.emplace_back(w, h, data); }
+            void add_level(unsigned int w, unsigned int h, std::vector<unsigned char>&& data) { m_levels.emplace_back(w, h, std::move(data)); }
+            // Store the compressed levels into the cache under the key, once all of them are compressed.
+            void store_to_cache(const MipmapCache& cache, uint64_t key) { cache.store(key, m_cache_writer); }
 
             void start_compressing();
 
@@ -118,6 +124,8 @@ namespace GUI {
     private:
         bool load_from_png(const std::string& filename, bool use_mipmaps, ECompressionType compression_type, bool apply_anisotropy);
         bool load_from_svg(const std::string& filename, bool use_mipmaps, bool compress, bool apply_anisotropy, unsigned int max_size_px);
+        // Sends the compressed levels cached by a former run of the compressor to gpu.
+        bool load_from_cache(uint64_t cache_key, bool apply_anisotropy);
 
         friend class Compressor;
     };
@@ -10,6 +10,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/filesystem.hpp>
 
 #include <wx/stdpaths.h>
 #include <wx/imagpng.h>
@@ -38,6 +39,7 @@
 #include "../Utils/PresetUpdater.hpp"
 #include "../Utils/PrintHost.hpp"
 #include "../Utils/MacDarkMode.hpp"
+#include "../Utils/SVGRasterCache.hpp"
 #include "ConfigWizard.hpp"
 #include "slic3r/Config/Snapshot.hpp"
 #include "ConfigSnapshotDialog.hpp"
@@ -197,6 +199,10 @@ bool GUI_App::on_init_inner()
     if (data_dir().empty())
         set_data_dir(wxStandardPaths::Get().GetUserDataDir().ToUTF8().data());
 
+    // Load the icons rasterized for the last session in parallel, before the first of them is requested.
+    m_svg_raster_cache.reset(new SVGRasterCache(var_dir(), (boost::filesystem::path(data_dir()) / "cache" / "icons").string()));
+    m_svg_raster_cache->preload();
+
     app_config = new AppConfig();
     preset_bundle = new PresetBundle();
 
@@ -274,6 +280,9 @@ bool GUI_App::on_init_inner()
         if (once) {
             once = false;
 
+            // The main window is shown with its icons, remember them to be preloaded on the next startup.
+            m_svg_raster_cache->save_index((unsigned int)this->em_unit());
+
             PresetUpdater::UpdateResult updater_result;
             try {
                 updater_result = preset_updater->config_update();
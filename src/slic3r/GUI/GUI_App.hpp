@@ -27,6 +27,7 @@ class PresetBundle;
 class PresetUpdater;
 class ModelObject;
 class PrintHostJobQueue;
+class SVGRasterCache;
 
 namespace GUI
 {
@@ -96,6 +97,7 @@ class GUI_App : public wxApp
 
     std::unique_ptr<ImGuiWrapper> m_imgui;
     std::unique_ptr<PrintHostJobQueue> m_printhost_job_queue;
+    std::unique_ptr<SVGRasterCache> m_svg_raster_cache;
 
 public:
     bool            OnInit() override;
@@ -182,6 +184,7 @@ public:
     ImGuiWrapper* imgui() { return m_imgui.get(); }
 
     PrintHostJobQueue& printhost_job_queue() { return *m_printhost_job_queue.get(); }
+    SVGRasterCache& svg_raster_cache() { return *m_svg_raster_cache.get(); }
 
     void            open_web_page_localized(const std::string &http_address);
 
@@ -1224,6 +1224,7 @@ void TabPrint::build()
         option.opt.full_width = true;
         option.opt.height = 5;//50;
         optgroup->append_single_option_line(option);
+        optgroup->append_single_option_line("post_process_streaming");
 
     page = add_options_page(_(L("Notes")), "note.png");
         optgroup = page->new_optgroup(_(L("Notes")), 0);
@@ -0,0 +1,279 @@
+#include "Mipmaps.hpp"
+
+#include "libslic3r/Utils.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <ctime>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#define STB_DXT_IMPLEMENTATION
+#include "stb_dxt/stb_dxt.h"
+
+#include "nanosvg/nanosvg.h"
+#include "nanosvg/nanosvgrast.h"
+
+namespace fs = boost::filesystem;
+
+namespace Slic3r {
+
+// Bump if the mipmap generation, the compression or the file format changes, so that the old textures are not reused.
+static const uint32_t MIPMAP_CACHE_VERSION = 1;
+static const char     MIPMAP_CACHE_MAGIC[4] = { 'D', 'X', 'T', '5' };
+
+void rasterize_svg(NSVGimage *image, float scale, unsigned int w, unsigned int h, std::vector<unsigned char> &out)
+{
+    out.assign(size_t(w) * size_t(h) * 4, 0);
+    // Each strip is rasterized with its own rasterizer, shifted up by the first row of the strip.
+    // As each rasterizer flattens the whole image, only about two strips per worker thread are created.
+    // The anti-aliasing of a few edge pixels may differ from a single pass of the rasterizer due to the shift.
+    unsigned int num_strips = 2 * (unsigned int)std::max(1, tbb::task_scheduler_init::default_num_threads());
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, h, std::max(16u, (h + num_strips - 1) / num_strips)),
+        [image, scale, w, &out](const tbb::blocked_range<unsigned int> &range) {
+            NSVGrasterizer *rast = ::nsvgCreateRasterizer();
+            if (rast == nullptr)
+                return;
+            ::nsvgRasterize(rast, image, 0, - (float)range.begin(), scale, out.data() + size_t(range.begin()) * w * 4, (int)w, (int)(range.end() - range.begin()), (int)w * 4);
+            ::nsvgDeleteRasterizer(rast);
+        });
+}
+
+void downscale_mipmap(const MipmapLevel &src, MipmapLevel &dst)
+{
+    dst.w = mipmap_next_size(src.w);
+    dst.h = mipmap_next_size(src.h);
+    dst.data.assign(size_t(dst.w) * size_t(dst.h) * 4, 0);
+    if (src.w == 2 * dst.w && src.h == 2 * dst.h) {
+        // Even sizes, each destination pixel is the average of a 2x2 block.
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, dst.h),
+            [&src, &dst](const tbb::blocked_range<unsigned int> &range) {
+                size_t src_stride = size_t(src.w) * 4;
+                for (unsigned int y = range.begin(); y < range.end(); ++ y) {
+                    const unsigned char *in0 = src.data.data() + 2 * size_t(y) * src_stride;
+                    const unsigned char *in1 = in0 + src_stride;
+                    unsigned char       *out = dst.data.data() + size_t(y) * dst.w * 4;
+                    for (unsigned int x = 0; x < dst.w; ++ x, in0 += 4, in1 += 4)
+                        for (int c = 0; c < 4; ++ c, ++ in0, ++ in1)
+                            *out ++ = (unsigned char)((in0[0] + in0[4] + in1[0] + in1[4] + 2) >> 2);
+                }
+            });
+        return;
+    }
+    // Ranges of the source columns covered by the destination columns. For odd source sizes, some destination pixels cover three source pixels.
+    auto ranges = [](unsigned int src_size, unsigned int dst_size) {
+        std::vector<unsigned int> out(dst_size + 1, 0);
+        for (unsigned int i = 1; i <= dst_size; ++ i)
+            out[i] = std::max(out[i - 1] + 1, (unsigned int)(uint64_t(i) * src_size / dst_size));
+        out.back() = src_size;
+        return out;
+    };
+    std::vector<unsigned int> cols = ranges(src.w, dst.w);
+    std::vector<unsigned int> rows = ranges(src.h, dst.h);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, dst.h),
+        [&src, &dst, &cols, &rows](const tbb::blocked_range<unsigned int> &range) {
+            for (unsigned int y = range.begin(); y < range.end(); ++ y) {
+                unsigned char *out = dst.data.data() + size_t(y) * dst.w * 4;
+                for (unsigned int x = 0; x < dst.w; ++ x) {
+                    unsigned int sum[4] = { 0, 0, 0, 0 };
+                    for (unsigned int sy = rows[y]; sy < rows[y + 1]; ++ sy) {
+                        const unsigned char *in = src.data.data() + (size_t(sy) * src.w + cols[x]) * 4;
+                        for (unsigned int sx = cols[x]; sx < cols[x + 1]; ++ sx)
+                            for (int c = 0; c < 4; ++ c)
+                                sum[c] += *in ++;
+                    }
+                    unsigned int n = (rows[y + 1] - rows[y]) * (cols[x + 1] - cols[x]);
+                    for (int c = 0; c < 4; ++ c)
+                        *out ++ = (unsigned char)((sum[c] + n / 2) / n);
+                }
+            }
+        });
+}
+
+void compress_dxt5(const MipmapLevel &src, MipmapLevel &dst)
+{
+    // reference: https://github.com/Cyan4973/RygsDXTc
+    dst.w = src.w;
+    dst.h = src.h;
+    dst.data.assign(dxt5_compressed_size(src.w, src.h), 0);
+    if (dst.data.empty())
+        return;
+
+    // stb_dxt initializes its lookup tables on the first use, do it before the worker threads start.
+    static bool initialized = [](){
+        unsigned char block_in[64] = { 0 };
+        unsigned char block_out[16];
+        stb_compress_dxt_block(block_out, block_in, 1, STB_DXT_NORMAL);
+        return true;
+    }();
+    (void)initialized;
+
+    unsigned int   block_cols = (src.w + 3) / 4;
+    unsigned int   block_rows = (src.h + 3) / 4;
+    unsigned char *src_data   = const_cast<unsigned char*>(src.data.data());
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, block_rows, 4),
+        [&src, &dst, src_data, block_cols](const tbb::blocked_range<unsigned int> &range) {
+            unsigned int y = range.begin() * 4;
+            int compressed_size = 0;
+            rygCompress(dst.data.data() + size_t(range.begin()) * block_cols * 16, src_data + size_t(y) * src.w * 4,
+                (int)src.w, (int)std::min(src.h - y, (range.end() - range.begin()) * 4), 1, compressed_size);
+        });
+}
+
+MipmapCache::MipmapCache(const std::string &cache_dir, size_t max_textures) :
+    m_cache_dir(cache_dir), m_max_textures(max_textures)
+{
+    if (! m_cache_dir.empty()) {
+        boost::system::error_code ec;
+        fs::create_directories(m_cache_dir, ec);
+        if (ec) {
+            BOOST_LOG_TRIVIAL(error) << boost::format("Failed to create the texture cache directory %1%: %2%") % m_cache_dir % ec.message();
+            m_cache_dir.clear();
+        }
+    }
+}
+
+uint64_t MipmapCache::key(const std::string &source_path, uint32_t max_tex_size, const std::vector<uint32_t> &params)
+{
+    std::vector<char> data;
+    if (! load_file(source_path, data))
+        return 0;
+    uint64_t hash = hash_fnv1a(data.data(), data.size());
+    hash = hash_fnv1a(&max_tex_size, sizeof(max_tex_size), hash);
+    hash = hash_fnv1a(params.data(), params.size() * sizeof(uint32_t), hash);
+    hash = hash_fnv1a(&MIPMAP_CACHE_VERSION, sizeof(MIPMAP_CACHE_VERSION), hash);
+    // Zero is reserved for "no key".
+    return std::max<uint64_t>(hash, 1);
+}
+
+std::string MipmapCache::texture_path(uint64_t key) const
+{
+    return (fs::path(m_cache_dir) / (boost::format("%016x.dxt5") % key).str()).string();
+}
+
+bool MipmapCache::load(uint64_t key, std::vector<MipmapLevel> &levels) const
+{
+    levels.clear();
+    if (m_cache_dir.empty() || key == 0)
+        return false;
+    std::string path = this->texture_path(key);
+    FILE *file = boost::nowide::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    char     magic[4];
+    uint32_t version;
+    bool ok = ::fread(magic, 1, 4, file) == 4 && ::memcmp(magic, MIPMAP_CACHE_MAGIC, 4) == 0 &&
+              ::fread(&version, sizeof(version), 1, file) == 1 && version == MIPMAP_CACHE_VERSION;
+    while (ok) {
+        uint32_t header[2];
+        if (::fread(header, sizeof(uint32_t), 2, file) != 2) {
+            ok = false;
+            break;
+        }
+        if (header[0] == 0 && header[1] == 0)
+            // End of the levels.
+            break;
+        if (header[0] == 0 || header[1] == 0 || header[0] > 65536 || header[1] > 65536) {
+            ok = false;
+            break;
+        }
+        levels.emplace_back();
+        MipmapLevel &level = levels.back();
+        level.w = header[0];
+        level.h = header[1];
+        level.data.assign(dxt5_compressed_size(level.w, level.h), 0);
+        ok = ::fread(level.data.data(), 1, level.data.size(), file) == level.data.size();
+    }
+    ::fclose(file);
+    if (! ok || levels.empty()) {
+        levels.clear();
+        return false;
+    }
+    // Mark the texture as recently used.
+    boost::system::error_code ec;
+    fs::last_write_time(path, std::time(nullptr), ec);
+    return true;
+}
+
+void MipmapCache::store(uint64_t key, Writer &writer) const
+{
+    writer.abort();
+    if (m_cache_dir.empty() || key == 0)
+        return;
+    writer.m_cache    = this;
+    writer.m_path     = this->texture_path(key);
+    writer.m_path_tmp = (fs::path(m_cache_dir) / fs::unique_path("%%%%-%%%%-%%%%.tmp")).string();
+    writer.m_file     = boost::nowide::fopen(writer.m_path_tmp.c_str(), "wb");
+    if (writer.m_file != nullptr &&
+        (::fwrite(MIPMAP_CACHE_MAGIC, 1, 4, writer.m_file) != 4 ||
+         ::fwrite(&MIPMAP_CACHE_VERSION, sizeof(MIPMAP_CACHE_VERSION), 1, writer.m_file) != 1))
+        writer.abort();
+}
+
+bool MipmapCache::Writer::append(const MipmapLevel &level)
+{
+    if (m_file == nullptr)
+        return false;
+    assert(level.w > 0 && level.h > 0 && level.data.size() == dxt5_compressed_size(level.w, level.h));
+    const uint32_t header[2] = { level.w, level.h };
+    if (::fwrite(header, sizeof(uint32_t), 2, m_file) != 2 ||
+        ::fwrite(level.data.data(), 1, level.data.size(), m_file) != level.data.size()) {
+        this->abort();
+        return false;
+    }
+    return true;
+}
+
+bool MipmapCache::Writer::commit()
+{
+    if (m_file == nullptr)
+        return false;
+    const uint32_t end[2] = { 0, 0 };
+    bool ok = ::fwrite(end, sizeof(uint32_t), 2, m_file) == 2;
+    ok = ::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    if (ok)
+        ok = ! rename_file(m_path_tmp, m_path);
+    if (! ok) {
+        BOOST_LOG_TRIVIAL(error) << "Failed to store the compressed texture into " << m_path;
+        boost::system::error_code ec;
+        fs::remove(m_path_tmp, ec);
+        return false;
+    }
+    m_cache->prune();
+    return true;
+}
+
+void MipmapCache::Writer::abort()
+{
+    if (m_file != nullptr) {
+        ::fclose(m_file);
+        m_file = nullptr;
+        boost::system::error_code ec;
+        fs::remove(m_path_tmp, ec);
+    }
+}
+
+void MipmapCache::prune() const
+{
+    std::vector<std::pair<std::time_t, fs::path>> textures;
+    boost::system::error_code ec;
+    for (fs::directory_iterator it(m_cache_dir, ec), end; ! ec && it != end; it.increment(ec))
+        if (is_plain_file(*it) && it->path().extension() == ".dxt5")
+            textures.emplace_back(fs::last_write_time(it->path(), ec), it->path());
+    if (textures.size() <= m_max_textures)
+        return;
+    // Remove the least recently used textures.
+    std::sort(textures.begin(), textures.end(), [](const std::pair<std::time_t, fs::path> &l, const std::pair<std::time_t, fs::path> &r) { return l.first > r.first; });
+    for (size_t i = m_max_textures; i < textures.size(); ++ i)
+        fs::remove(textures[i].second, ec);
+}
+
+} // namespace Slic3r
@@ -0,0 +1,97 @@
+#ifndef slic3r_Mipmaps_hpp_
+#define slic3r_Mipmaps_hpp_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct NSVGimage;
+
+namespace Slic3r {
+
+// CPU side of the texture loading: Generation of the mipmap levels, their DXT5 compression
+// and the on-disk cache of the compressed levels. Independent of OpenGL.
+
+struct MipmapLevel
+{
+    unsigned int                w = 0;
+    unsigned int                h = 0;
+    // RGBA data of an uncompressed level, DXT5 blocks of a compressed level.
+    std::vector<unsigned char>  data;
+};
+
+// Size of the next mipmap level.
+inline unsigned int mipmap_next_size(unsigned int size) { return std::max(size / 2, 1u); }
+// The mipmap levels are not generated down to 1x1, the last level has both sizes at most 16 pixels.
+inline bool         mipmap_has_next(unsigned int w, unsigned int h) { return w > 16 || h > 16; }
+
+// Rasterize the SVG image with the scale into a w x h RGBA buffer. Horizontal strips are rasterized in parallel.
+extern void         rasterize_svg(NSVGimage *image, float scale, unsigned int w, unsigned int h, std::vector<unsigned char> &out);
+// Downscale an RGBA level to the next mipmap level by averaging the source pixels covered by each destination pixel.
+// Rows are processed in parallel.
+extern void         downscale_mipmap(const MipmapLevel &src, MipmapLevel &dst);
+
+// Size of the DXT5 compressed w x h RGBA image.
+inline size_t       dxt5_compressed_size(unsigned int w, unsigned int h) { return size_t((w + 3) / 4) * size_t((h + 3) / 4) * 16; }
+// Compress the RGBA level to DXT5. Rows of 4x4 blocks are compressed in parallel, the result is equal to a single pass of rygCompress().
+extern void         compress_dxt5(const MipmapLevel &src, MipmapLevel &dst);
+
+// Cache of the DXT5 compressed mipmap levels of the textures, addressed by a hash of the source image and of the texture parameters.
+// Only the least recently used few textures are kept, as the compressed textures of the print beds take tens of megabytes.
+class MipmapCache
+{
+public:
+    // If cache_dir is empty, nothing is cached.
+    explicit MipmapCache(const std::string &cache_dir, size_t max_textures = 4);
+
+    // Key of a texture loaded from a file, the params define how the file is converted into the texture.
+    // The maximum texture size of the OpenGL driver is part of the key, as it limits the size of the levels
+    // and a cached texture must not be reused after switching to a GPU with a lower limit.
+    // Returns zero if the file could not be read.
+    static uint64_t key(const std::string &source_path, uint32_t max_tex_size, const std::vector<uint32_t> &params);
+
+    // Load the compressed levels. Returns false if the texture is not cached.
+    bool            load(uint64_t key, std::vector<MipmapLevel> &levels) const;
+
+    // Stores the levels of a texture one by one as they are compressed,
+    // the texture is published to the cache by commit() only.
+    class Writer
+    {
+    public:
+        Writer() {}
+        Writer(const Writer &rhs) = delete;
+        Writer& operator=(const Writer &rhs) = delete;
+        ~Writer() { this->abort(); }
+
+        bool        valid() const { return m_file != nullptr; }
+        // Append the next compressed level. Returns false on failure, the texture will not be stored then.
+        bool        append(const MipmapLevel &level);
+        // Publish the texture in the cache, remove the least recently used textures over the limit.
+        bool        commit();
+        // Discard the levels written.
+        void        abort();
+
+    private:
+        friend class MipmapCache;
+        const MipmapCache  *m_cache = nullptr;
+        FILE               *m_file  = nullptr;
+        std::string         m_path;
+        std::string         m_path_tmp;
+    };
+
+    // Start writing a texture into the cache. Returns an invalid writer if the cache is disabled or the file could not be created.
+    void            store(uint64_t key, Writer &writer) const;
+
+private:
+    std::string     texture_path(uint64_t key) const;
+    void            prune() const;
+
+    std::string     m_cache_dir;
+    size_t          m_max_textures;
+};
+
+} // namespace Slic3r
+
+#endif /* slic3r_Mipmaps_hpp_ */
@@ -0,0 +1,286 @@
+#include "SVGRasterCache.hpp"
+
+#include "libslic3r/Utils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <sstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/format.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include <tbb/parallel_for.h>
+#include <tbb/tick_count.h>
+
+#define NANOSVG_IMPLEMENTATION
+#include "nanosvg/nanosvg.h"
+#define NANOSVGRAST_IMPLEMENTATION
+#include "nanosvg/nanosvgrast.h"
+
+namespace fs = boost::filesystem;
+
+namespace Slic3r {
+
+// Bump if the rasterization or the raster file format changes, so that the old rasters are not reused.
+static const uint32_t RASTER_FORMAT_VERSION = 1;
+static const char     RASTER_MAGIC[4] = { 'S', 'V', 'G', 'R' };
+
+SVGRasterCache::SVGRasterCache(const std::string &icons_dir, const std::string &cache_dir) :
+    m_icons_dir(icons_dir), m_cache_dir(cache_dir)
+{
+    if (! m_cache_dir.empty()) {
+        boost::system::error_code ec;
+        fs::create_directories(m_cache_dir, ec);
+        if (ec) {
+            BOOST_LOG_TRIVIAL(error) << boost::format("Failed to create the icon cache directory %1%: %2%") % m_cache_dir % ec.message();
+            m_cache_dir.clear();
+        }
+    }
+}
+
+bool SVGRasterCache::rasterize(std::vector<char> &svg_data, unsigned int target_width, unsigned int target_height, Raster &out)
+{
+    // nsvgParse() expects a zero terminated string and it modifies it.
+    svg_data.push_back(0);
+    NSVGimage *image = ::nsvgParse(svg_data.data(), "px", 96.0f);
+    svg_data.pop_back();
+    if (image == nullptr)
+        return false;
+
+    float svg_scale = target_height != 0 ?
+                  (float)target_height / image->height  : target_width != 0 ?
+                  (float)target_width / image->width    : 1;
+
+    int   width    = (int)(svg_scale * image->width + 0.5f);
+    int   height   = (int)(svg_scale * image->height + 0.5f);
+    int   n_pixels = width * height;
+    if (n_pixels <= 0) {
+        ::nsvgDelete(image);
+        return false;
+    }
+
+    NSVGrasterizer *rast = ::nsvgCreateRasterizer();
+    if (rast == nullptr) {
+        ::nsvgDelete(image);
+        return false;
+    }
+
+    out.width  = (unsigned int)width;
+    out.height = (unsigned int)height;
+    out.rgba.assign(n_pixels * 4, 0);
+    ::nsvgRasterize(rast, image, 0, 0, svg_scale, out.rgba.data(), width, height, width * 4);
+    ::nsvgDeleteRasterizer(rast);
+    ::nsvgDelete(image);
+    return true;
+}
+
+uint64_t SVGRasterCache::raster_hash(const std::vector<char> &svg_data, unsigned int target_width, unsigned int target_height)
+{
+    // Hash of the SVG content, the raster size and the raster format version.
+    const uint32_t params[3] = { target_width, target_height, RASTER_FORMAT_VERSION };
+    return hash_fnv1a(params, sizeof(params), hash_fnv1a(svg_data.data(), svg_data.size()));
+}
+
+bool SVGRasterCache::load_raster(const std::string &path, Raster &out)
+{
+    FILE *file = boost::nowide::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    char     magic[4];
+    uint32_t header[3];
+    bool ok = ::fread(magic, 1, 4, file) == 4 && ::memcmp(magic, RASTER_MAGIC, 4) == 0 &&
+              ::fread(header, sizeof(uint32_t), 3, file) == 3 && header[0] == RASTER_FORMAT_VERSION &&
+              header[1] > 0 && header[2] > 0 && header[1] <= 65536 && header[2] <= 65536;
+    if (ok) {
+        out.width  = header[1];
+        out.height = header[2];
+        out.rgba.assign(size_t(out.width) * size_t(out.height) * 4, 0);
+        ok = ::fread(out.rgba.data(), 1, out.rgba.size(), file) == out.rgba.size() && ::fgetc(file) == EOF;
+    }
+    ::fclose(file);
+    return ok;
+}
+
+bool SVGRasterCache::save_raster(const std::string &path, const Raster &raster)
+{
+    // Write into a temporary file first, so that a concurrently running application or a crash will never see a partial raster.
+    std::string path_tmp = (fs::path(path).parent_path() / fs::unique_path("%%%%-%%%%-%%%%.tmp")).string();
+    FILE *file = boost::nowide::fopen(path_tmp.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+    const uint32_t header[3] = { RASTER_FORMAT_VERSION, raster.width, raster.height };
+    bool ok = ::fwrite(RASTER_MAGIC, 1, 4, file) == 4 &&
+              ::fwrite(header, sizeof(uint32_t), 3, file) == 3 &&
+              ::fwrite(raster.rgba.data(), 1, raster.rgba.size(), file) == raster.rgba.size();
+    ok = ::fclose(file) == 0 && ok;
+    if (ok)
+        ok = ! rename_file(path_tmp, path);
+    if (! ok) {
+        boost::system::error_code ec;
+        fs::remove(path_tmp, ec);
+    }
+    return ok;
+}
+
+std::string SVGRasterCache::request_key(const std::string &icon_name, unsigned int target_width, unsigned int target_height)
+{
+    return icon_name + "-w" + std::to_string(target_width) + "-h" + std::to_string(target_height);
+}
+
+std::string SVGRasterCache::raster_path(uint64_t hash) const
+{
+    return (fs::path(m_cache_dir) / (boost::format("%016x.rgba") % hash).str()).string();
+}
+
+std::string SVGRasterCache::index_path() const
+{
+    return (fs::path(m_cache_dir) / "index.txt").string();
+}
+
+bool SVGRasterCache::resolve(const std::string &icon_name, unsigned int target_width, unsigned int target_height, uint64_t &hash, Raster &out) const
+{
+    std::vector<char> svg_data;
+    if (! load_file((fs::path(m_icons_dir) / (icon_name + ".svg")).string(), svg_data))
+        return false;
+    hash = raster_hash(svg_data, target_width, target_height);
+    if (m_cache_dir.empty())
+        return rasterize(svg_data, target_width, target_height, out);
+    std::string path = this->raster_path(hash);
+    if (load_raster(path, out))
+        return true;
+    if (! rasterize(svg_data, target_width, target_height, out))
+        return false;
+    if (! save_raster(path, out))
+        BOOST_LOG_TRIVIAL(error) << "Failed to store the rasterized icon " << icon_name << " into " << path;
+    return true;
+}
+
+void SVGRasterCache::preload()
+{
+    if (m_cache_dir.empty())
+        return;
+
+    std::vector<Request> requests;
+    {
+        fs::ifstream file(index_path());
+        std::string  line;
+        while (std::getline(file, line)) {
+            std::istringstream is(line);
+            if (boost::starts_with(line, "scale ")) {
+                // Screen scale of the session, which saved the index.
+                is.ignore(6);
+                is >> m_index_scale;
+                if (is.fail())
+                    m_index_scale = 0;
+                continue;
+            }
+            Request request;
+            is >> std::hex >> request.hash >> std::dec >> request.target_width >> request.target_height >> std::ws;
+            if (is.fail())
+                continue;
+            std::getline(is, request.icon_name);
+            if (! request.icon_name.empty())
+                requests.emplace_back(std::move(request));
+        }
+    }
+    if (requests.empty())
+        return;
+
+    tbb::tick_count t0 = tbb::tick_count::now();
+    std::vector<Preloaded> preloaded(requests.size());
+    std::vector<char>      valid(requests.size(), false);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, requests.size()),
+        [this, &requests, &preloaded, &valid](const tbb::blocked_range<size_t> &range) {
+            for (size_t i = range.begin(); i < range.end(); ++ i) {
+                const Request &request = requests[i];
+                valid[i] = this->resolve(request.icon_name, request.target_width, request.target_height, preloaded[i].hash, preloaded[i].raster);
+            }
+        });
+
+    // Hashes of all the valid rasters, as multiple icons may share the same content.
+    std::set<uint64_t> hashes;
+    for (size_t i = 0; i < requests.size(); ++ i)
+        if (valid[i])
+            hashes.insert(preloaded[i].hash);
+    size_t num_stale = 0;
+    for (size_t i = 0; i < requests.size(); ++ i) {
+        if (! valid[i])
+            continue;
+        if (requests[i].hash != preloaded[i].hash) {
+            // The icon has changed since the last session, drop its old raster.
+            if (hashes.find(requests[i].hash) == hashes.end()) {
+                boost::system::error_code ec;
+                fs::remove(this->raster_path(requests[i].hash), ec);
+            }
+            ++ num_stale;
+        }
+        m_preloaded[request_key(requests[i].icon_name, requests[i].target_width, requests[i].target_height)] = std::move(preloaded[i]);
+    }
+    BOOST_LOG_TRIVIAL(info) << boost::format("Preloaded %1% icons (%2% of them changed) in %3% ms")
+        % m_preloaded.size() % num_stale % int((tbb::tick_count::now() - t0).seconds() * 1000.);
+}
+
+bool SVGRasterCache::get(const std::string &icon_name, unsigned int target_width, unsigned int target_height, Raster &out)
+{
+    std::string key  = request_key(icon_name, target_width, target_height);
+    uint64_t    hash = 0;
+    auto it = m_preloaded.find(key);
+    if (it != m_preloaded.end()) {
+        hash = it->second.hash;
+        out  = std::move(it->second.raster);
+        m_preloaded.erase(it);
+    } else if (! this->resolve(icon_name, target_width, target_height, hash, out))
+        return false;
+    m_requests.emplace(std::move(key), Request { icon_name, target_width, target_height, hash });
+    return true;
+}
+
+void SVGRasterCache::evict_unrequested() const
+{
+    std::set<uint64_t> hashes;
+    for (const std::pair<const std::string, Request> &kvp : m_requests)
+        hashes.insert(kvp.second.hash);
+    size_t num_removed = 0;
+    boost::system::error_code ec;
+    for (fs::directory_iterator it(m_cache_dir, ec), end; ! ec && it != end; it.increment(ec)) {
+        const fs::path &path = it->path();
+        if (! is_plain_file(*it) || path.extension() != ".rgba")
+            continue;
+        std::istringstream is(path.stem().string());
+        uint64_t hash = 0;
+        is >> std::hex >> hash;
+        if (is.fail() || hashes.find(hash) == hashes.end()) {
+            boost::system::error_code ec_remove;
+            if (fs::remove(path, ec_remove))
+                ++ num_removed;
+        }
+    }
+    BOOST_LOG_TRIVIAL(info) << boost::format("Removed %1% icons rasterized at another screen scale") % num_removed;
+}
+
+void SVGRasterCache::save_index(unsigned int scale)
+{
+    if (m_cache_dir.empty() || m_requests.empty())
+        return;
+    if (scale != m_index_scale) {
+        // All the icon sizes change with the screen scale, the rasters of the previous scale will not be requested anymore.
+        this->evict_unrequested();
+        m_index_scale = scale;
+    }
+    std::string  path     = index_path();
+    std::string  path_tmp = path + ".tmp";
+    fs::ofstream file(path_tmp);
+    file << "scale " << scale << "\n";
+    for (const std::pair<const std::string, Request> &kvp : m_requests)
+        file << boost::format("%016x %d %d %s\n") % kvp.second.hash % kvp.second.target_width % kvp.second.target_height % kvp.second.icon_name;
+    file.close();
+    if (file.fail() || rename_file(path_tmp, path))
+        BOOST_LOG_TRIVIAL(error) << "Failed to save the icon cache index " << path;
+}
+
+} // namespace Slic3r
@@ -0,0 +1,88 @@
+#ifndef slic3r_SVGRasterCache_hpp_
+#define slic3r_SVGRasterCache_hpp_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Slic3r {
+
+// Persistent cache of the SVG icons rasterized to RGBA buffers.
+// Rasterizing the SVG icons with nanosvg at the current screen scale takes a noticeable part of the application startup.
+// The rasters are stored into the cache directory under a name derived from a hash of the SVG file content
+// and of the raster size, so a changed icon or a changed screen scale simply lands in a new file.
+// The icons requested during the startup are recorded into an index, which is used to load or rasterize
+// all of them in parallel on the next startup. The index also records the screen scale it was saved at.
+// If the scale changes, the rasters not requested at the new scale are removed, as all the icon sizes change with it.
+// The cache works on raw RGBA buffers only and it does not depend on wxWidgets.
+class SVGRasterCache
+{
+public:
+    struct Raster
+    {
+        unsigned int                width  = 0;
+        unsigned int                height = 0;
+        // width * height RGBA quadruples, not premultiplied.
+        std::vector<unsigned char>  rgba;
+    };
+
+    // icons_dir: Directory of the SVG files, icon names are relative to this directory, without the .svg suffix.
+    // cache_dir: Directory of the rasters and of the index, created on demand. If empty, nothing is stored on disk.
+    SVGRasterCache(const std::string &icons_dir, const std::string &cache_dir);
+
+    // Load or rasterize the icons recorded in the index by save_index() of the last session, in parallel.
+    void        preload();
+    // Get the raster of an icon of target_height (or target_width if target_height is zero) in screen pixels.
+    // The raster is taken from the preloaded ones, from the disk or rasterized and stored to the disk.
+    // Returns false if the icon does not exist or it could not be rasterized.
+    bool        get(const std::string &icon_name, unsigned int target_width, unsigned int target_height, Raster &out);
+    // Save the icons requested from this instance into the index for preload() of the next session.
+    // scale is the screen scale the icons were requested at, for example the em unit of the main window.
+    // If it differs from the scale of the index loaded by preload(), the rasters not requested from this instance are removed.
+    void        save_index(unsigned int scale);
+
+    // Rasterize the SVG data to target_height (or target_width if target_height is zero). svg_data will be modified.
+    static bool rasterize(std::vector<char> &svg_data, unsigned int target_width, unsigned int target_height, Raster &out);
+    // Content hash of the SVG data and of the raster size, which addresses the raster in the cache directory.
+    static uint64_t raster_hash(const std::vector<char> &svg_data, unsigned int target_width, unsigned int target_height);
+    static bool load_raster(const std::string &path, Raster &out);
+    static bool save_raster(const std::string &path, const Raster &raster);
+
+private:
+    struct Request
+    {
+        std::string     icon_name;
+        unsigned int    target_width;
+        unsigned int    target_height;
+        // Hash of the raster, see raster_hash().
+        uint64_t        hash;
+    };
+
+    struct Preloaded
+    {
+        uint64_t        hash = 0;
+        Raster          raster;
+    };
+
+    static std::string  request_key(const std::string &icon_name, unsigned int target_width, unsigned int target_height);
+    std::string         raster_path(uint64_t hash) const;
+    std::string         index_path() const;
+    // Read the SVG file, find or produce its raster. Thread safe.
+    bool                resolve(const std::string &icon_name, unsigned int target_width, unsigned int target_height, uint64_t &hash, Raster &out) const;
+    // Remove the rasters of the cache directory, which were not requested from this instance.
+    void                evict_unrequested() const;
+
+    std::string                      m_icons_dir;
+    std::string                      m_cache_dir;
+    // Rasters loaded by preload(), which were not requested yet. Moved out by get().
+    std::map<std::string, Preloaded> m_preloaded;
+    // Icons requested from this instance, to be saved into the index.
+    std::map<std::string, Request>   m_requests;
+    // Screen scale of the index loaded by preload(), zero if there was no index.
+    unsigned int                     m_index_scale = 0;
+};
+
+} // namespace Slic3r
+
+#endif /* slic3r_SVGRasterCache_hpp_ */
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <memory>
 #include <typeinfo> 
+#include <unordered_map>
 #include <cassert>
 #include <cstddef>
 
@@ -587,7 +588,7 @@ private:
 		if (it == m_shared_ptr_to_object_id.end()) {
 			// Allocate a new temporary ObjectID for this shared pointer.
 			ObjectBase object_with_id;
-			it = m_shared_ptr_to_object_id.insert(it, std::make_pair(ptr, object_with_id.id()));
+			it = m_shared_ptr_to_object_id.emplace(ptr, object_with_id.id()).first;
 		}
 		return it->second;
 	}
@@ -599,8 +600,9 @@ private:
 	// Each individual object (Model, ModelObject, ModelInstance, ModelVolume, Selection, TriangleMesh)
 	// is stored with its own history, referenced by the ObjectID. Immutable objects do not provide
 	// their own IDs, therefore there are temporary IDs generated for them and stored to m_shared_ptr_to_object_id.
+	// Ordered, so that release_least_recently_used() trims the histories in a deterministic order.
 	std::map<ObjectID, std::unique_ptr<ObjectHistoryBase>> 	m_objects;
-	std::map<const void*, ObjectID>							m_shared_ptr_to_object_id;
+	std::unordered_map<const void*, ObjectID>				m_shared_ptr_to_object_id;
 	// Snapshot history (names with timestamps).
 	std::vector<Snapshot>									m_snapshots;
 	// Timestamp of the active snapshot.